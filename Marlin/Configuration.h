@@ -135,6 +135,11 @@
 #define MKS_WIFI
 #if ENABLED(MKS_WIFI)
 //  #define SHOW_PROGRESS
+  #define MKS_WIFI_BACKGROUND_UPLOAD    // Receive uploaded files from idle(): printing and heaters keep running
+  #if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+    #define MKS_WIFI_UPLOAD_TIMEOUT 5000  // (ms) Abort the upload if the ESP stops sending data
+    #define MKS_WIFI_COMPRESSED_UPLOAD    // Accept heatshrink-compressed file fragments (ESP_TYPE_FILE_FRAGMENT_HS)
+  #endif
   #define SERIAL_PORT_2 1
   #define BAUDRATE_2 115200   // Enable to override BAUDRATE
 #endif
@@ -1691,9 +1696,13 @@
   //===========================================================================
 
   #define MESH_INSET 45          // Set Mesh bounds as an inset region of the bed
-  #define GRID_MAX_POINTS_X 3    // Don't use more than 7 points per axis, implementation limited.
+  #define GRID_MAX_POINTS_X 3
   #define GRID_MAX_POINTS_Y GRID_MAX_POINTS_X
 
+  // Keep a bilinear patch per mesh cell so leveled moves need no divisions.
+  // Costs 16 bytes of RAM per cell, refreshed whenever the mesh changes.
+  //#define MBL_CELL_TABLE
+
   //#define MESH_G28_REST_ORIGIN // After homing all axes ('G28' or 'G28 XYZ') rest Z at Z_MIN_POS
 
 #endif // BED_LEVELING
@@ -3046,12 +3055,16 @@ EEPROM_W25Q
 #if ENABLED(TOUCH_SCREEN)
   #if ENABLED(TFT_COLOR_UI)
     #define RS_STYLE_COLOR_UI
+    #ifdef ARDUINO_ARCH_STM32
+      #define TFT_DOUBLE_BUFFER   // Compose the next canvas strip while DMA sends the previous one (FSMC only)
+    #endif
   #endif
 #endif
 
 #ifdef MCU_STM32F407VE
   #if ENABLED(RS_STYLE_COLOR_UI)
     #define THUMBNAILS_PREVIEW
+    #define THUMBNAILS_CACHE      // Keep decoded previews as RGB565 files in /THUMBS on the SD card
   #endif
 #endif
 
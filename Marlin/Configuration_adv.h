@@ -438,6 +438,31 @@
 // Enable for M105 to include ADC values read from temperature sensors.
 //#define SHOW_TEMP_ADC_VALUES
 
+/**
+ * Thermistor Lookup Table
+ *
+ * Convert hotend and bed thermistor readings with a table in RAM, built from
+ * the thermistor table whenever the sensor type changes. A reading then takes
+ * one indexed load and a fixed-point interpolation instead of a table search
+ * and a float divide. The table has one cell per 10-bit ADC count, the same
+ * resolution as the thermistor tables, and uses about 2K of RAM per sensor.
+ */
+//#define THERMISTOR_LUT
+
+/**
+ * ADC DMA Scan (STM32F1 / STM32F4)
+ *
+ * Convert all analog inputs continuously with ADC1 in scan mode, letting DMA
+ * fill a ring of ADC_DMA_OVERSAMPLE samples per input. Reading a sensor only
+ * averages its samples, so the temperature ISR never waits on a conversion.
+ * Inputs not on ADC1 fall back to analogRead. Don't use analogRead (e.g.,
+ * M43) on ADC1 pins while this is enabled, as it reconfigures the ADC.
+ */
+//#define ADC_DMA_SCAN
+#if ENABLED(ADC_DMA_SCAN)
+  #define ADC_DMA_OVERSAMPLE 32   // Samples averaged per reading (power of 2, 1-256)
+#endif
+
 /**
  * High Temperature Thermistor Support
  *
@@ -1185,6 +1210,32 @@
  */
 #define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Input Shaping
+ *
+ * Cancel the ringing of the X and Y axes by splitting every step into timed impulses
+ * tuned to the resonant frequency of each axis. Measure the frequency from the ringing
+ * on a test print (ringing period = distance between ripples / print speed).
+ *
+ * Shaper types: 0 = ZV (shortest), 1 = ZVD, 2 = MZV, 3 = EI (most tolerant of a wrong frequency)
+ *
+ * Set the values with 'M593 [X] [Y] F<hz> D<damping> T<type>' and save them with M500.
+ *
+ * On COREXY / COREYX both motors move both axes, so they share the X values.
+ */
+//#define INPUT_SHAPING
+#if ENABLED(INPUT_SHAPING)
+  #define SHAPING_FREQ_X       0    // (Hz) Resonant frequency of the X axis. 0 to disable.
+  #define SHAPING_FREQ_Y       0    // (Hz) Resonant frequency of the Y axis. 0 to disable.
+  #define SHAPING_ZETA_X    0.10    // Damping ratio of the X axis (0.0 - 0.99)
+  #define SHAPING_ZETA_Y    0.10    // Damping ratio of the Y axis (0.0 - 0.99)
+  #define SHAPING_TYPE_X       2    // Shaper type of the X axis
+  #define SHAPING_TYPE_Y       2    // Shaper type of the Y axis
+  #define SHAPING_BUFFER_SIZE 512   // Delayed steps held per axis (power of 2, 4 bytes each).
+                                    // Needs step rate * shaper duration. Excess steps go out unshaped.
+  #define SHAPING_MENU              // Edit the shaping values in Advanced Settings
+#endif
+
 /**
  * Custom Microstepping
  * Override as-needed for your setup. Up to 3 MS pins are supported.
@@ -1431,6 +1482,23 @@
 
   #define SD_PROCEDURE_DEPTH 1              // Increase if you need more nested M32 calls
 
+  // Read the printed file ahead in multi-block transfers of up to this many 512-byte
+  // sectors (1-63). Costs 512 bytes of SRAM per sector. Comment out to read byte by byte.
+  #define SD_READ_AHEAD_BLOCKS 4
+
+  // Map the printed file as up to this many runs of contiguous clusters when the print
+  // starts, so reads and seeks (M26, resume) skip the FAT. Costs 8 bytes of SRAM per run.
+  #define SD_EXTENT_CACHE 32
+
+  // Sectors cached in front of the card, shared by the SD printing stack and the MKS WiFi
+  // FatFs uploads so both keep warm FAT and directory sectors. Costs 520 bytes of SRAM each.
+  #define SD_BLOCK_CACHE 4
+
+  // Index this many items of the current folder by directory position, so the file
+  // browser counts and pages large folders without rescanning them. The index is dropped
+  // when the folder or the card's directory/FAT changes. Costs 2 bytes of SRAM each.
+  #define SD_DIR_INDEX 256
+
   #define SD_FINISHED_STEPPERRELEASE true   // Disable steppers when SD Print is finished
   #define SD_FINISHED_RELEASECOMMAND "M84"  // Use "M84XYE" to keep Z enabled so your bed stays in place
 
@@ -2152,9 +2220,12 @@
 #define ARC_SUPPORT                   // Requires ~3226 bytes
 #if ENABLED(ARC_SUPPORT)
   #define MIN_ARC_SEGMENT_MM      0.1 // (mm) Minimum length of each arc segment
-  #define MAX_ARC_SEGMENT_MM      1.0 // (mm) Maximum length of each arc segment
+  #define MAX_ARC_SEGMENT_MM      5.0 // (mm) Maximum length of each arc segment
   #define MIN_CIRCLE_SEGMENTS    72   // Minimum number of segments in a complete circle
   //#define ARC_SEGMENTS_PER_SEC 50   // Use the feedrate to choose the segment length
+  #define ARC_CHORD_TOLERANCE  0.01   // (mm) Use the radius to choose the segment length, keeping
+                                      // each chord within this distance of the true arc. Large
+                                      // radii get fewer, longer segments, up to MAX_ARC_SEGMENT_MM.
   #define N_ARC_CORRECTION       25   // Number of interpolated segments between corrections
   //#define ARC_P_CIRCLES             // Enable the 'P' parameter to specify complete circles
   //#define SF_ARC_FIX                // Enable only if using SkeinForge with "Arc Point" fillet procedure
@@ -2257,11 +2328,27 @@
   #define BLOCK_BUFFER_SIZE 16
 #endif
 
+/**
+ * Run the plain G1 X Y E [F] moves that follow each other in the command queue
+ * back to back, without a pass through the main loop between them, and plan them
+ * as one group. Raises the rate of short moves (e.g., curves sliced into 0.1mm
+ * segments) the planner can keep up with on slower boards.
+ */
+#define BATCH_LINEAR_MOVES
+#if ENABLED(BATCH_LINEAR_MOVES)
+  #define BATCH_LINEAR_MOVES_MAX 8  // Moves per group. Heaters and UI are serviced between groups.
+#endif
+
 // @section serial
 
 // The ASCII buffer for serial input
 #define MAX_CMD_SIZE 96
-#define BUFSIZE 32
+#define BUFSIZE 64
+
+// Pack the text of queued commands back-to-back in a ring of this many bytes instead of
+// giving every command a MAX_CMD_SIZE slot. Typical moves use a third of a slot, so
+// BUFSIZE commands fit in far less SRAM. Disable to use fixed slots (then use BUFSIZE 32).
+#define COMMAND_RING_SIZE 3072
 
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
@@ -4334,6 +4421,20 @@
   //#define BUFFER_MONITORING
 #endif
 
+/**
+ * M981 - Stepper ISR profiling
+ * Count CPU cycles of each Stepper ISR phase (pulse, block, advance, babystep)
+ * with min/avg/max and a histogram, to find which one limits the step rate.
+ */
+//#define STEPPER_ISR_PROFILING
+
+/**
+ * M982 - Planner telemetry
+ * Time spent replanning the look-ahead, blocks replanned per new move, a
+ * histogram of the queue depth and the limits capping the junction speeds.
+ */
+//#define PLANNER_TELEMETRY
+
 /**
  * Postmortem Debugging captures misbehavior and outputs the CPU status and backtrace to serial.
  * When running in the debugger it will break for debugging. This is useful to help understand
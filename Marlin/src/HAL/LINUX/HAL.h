@@ -78,6 +78,12 @@ extern MSerialT usb_serial;
 
 inline void HAL_init() {}
 
+#ifdef MOTION_REPLAY
+  // Waits in idle() must let simulated time pass
+  #define HAL_IDLETASK 1
+  void HAL_idletask();
+#endif
+
 // Utility functions
 #pragma GCC diagnostic push
 #if GCC_VERSION <= 50000
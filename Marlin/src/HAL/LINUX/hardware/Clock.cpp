@@ -24,8 +24,15 @@
 #include "../../../inc/MarlinConfig.h"
 #include "Clock.h"
 
-std::chrono::nanoseconds Clock::startup = std::chrono::high_resolution_clock::now().time_since_epoch();
 uint32_t Clock::frequency = F_CPU;
 double Clock::time_multiplier = 1.0;
 
+#ifdef MOTION_REPLAY
+  std::chrono::nanoseconds Clock::startup { 0 };
+  uint64_t Clock::virtual_nanos = 0;
+  void (*Clock::idler)(uint64_t until) = nullptr;
+#else
+  std::chrono::nanoseconds Clock::startup = std::chrono::high_resolution_clock::now().time_since_epoch();
+#endif
+
 #endif // __PLAT_LINUX__
@@ -45,10 +45,32 @@ public:
 
   // Time Acceleration compensated
   static uint64_t nanos() {
-    auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
-    return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
+    #ifdef MOTION_REPLAY
+      return Clock::virtual_nanos;
+    #else
+      auto now = std::chrono::high_resolution_clock::now().time_since_epoch();
+      return (now.count() - Clock::startup.count()) * Clock::time_multiplier;
+    #endif
   }
 
+  #ifdef MOTION_REPLAY
+    // Simulated time only moves when advanced. A delay hands the wait to the
+    // idler, which runs whatever falls due in the meantime.
+    static void advance(uint64_t ns) { Clock::virtual_nanos += ns; }
+
+    static void advanceTo(uint64_t ns) {
+      if (ns > Clock::virtual_nanos) Clock::virtual_nanos = ns;
+    }
+
+    static void wait(uint64_t ns) {
+      const uint64_t until = Clock::virtual_nanos + ns;
+      if (Clock::idler) Clock::idler(until);
+      Clock::advanceTo(until);
+    }
+
+    static void setIdler(void (*fn)(uint64_t until)) { Clock::idler = fn; }
+  #endif
+
   static uint64_t micros() {
     return Clock::nanos() / 1000;
   }
@@ -61,21 +83,32 @@ public:
     return Clock::nanos() / 1000000000.0;
   }
 
-  static void delayCycles(uint64_t cycles) {
-    std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
-  }
+  #ifdef MOTION_REPLAY
 
-  static void delayMicros(uint64_t micros) {
-    std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
-  }
+    static void delayCycles(uint64_t cycles) { Clock::wait((1000000000L / frequency) * cycles); }
+    static void delayMicros(uint64_t micros) { Clock::wait(micros * 1000); }
+    static void delayMillis(uint64_t millis) { Clock::wait(millis * 1000000); }
+    static void delaySeconds(double secs)    { Clock::wait(secs * 1000000000.0); }
 
-  static void delayMillis(uint64_t millis) {
-    std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
-  }
+  #else
 
-  static void delaySeconds(double secs) {
-    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
-  }
+    static void delayCycles(uint64_t cycles) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds( (1000000000L / frequency) * cycles) / Clock::time_multiplier );
+    }
+
+    static void delayMicros(uint64_t micros) {
+      std::this_thread::sleep_for(std::chrono::microseconds( micros ) / Clock::time_multiplier);
+    }
+
+    static void delayMillis(uint64_t millis) {
+      std::this_thread::sleep_for(std::chrono::milliseconds( millis ) / Clock::time_multiplier);
+    }
+
+    static void delaySeconds(double secs) {
+      std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(secs * 1000) / Clock::time_multiplier);
+    }
+
+  #endif
 
   // Will reduce timer resolution increasing likelihood of overflows
   static void setTimeMultiplier(double tm) {
@@ -86,4 +119,8 @@ private:
   static std::chrono::nanoseconds startup;
   static uint32_t frequency;
   static double time_multiplier;
+  #ifdef MOTION_REPLAY
+    static uint64_t virtual_nanos;
+    static void (*idler)(uint64_t until);
+  #endif
 };
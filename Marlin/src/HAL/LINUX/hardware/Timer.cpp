@@ -34,8 +34,68 @@ Timer::Timer() {
   period = 0;
   start_time = 0;
   avg_error = 0;
+  #ifdef MOTION_REPLAY
+    deadline = 0;
+    fires = 0;
+    late_total = 0;
+    late_max = 0;
+  #endif
 }
 
+#ifdef MOTION_REPLAY
+
+Timer::~Timer() {}
+
+void Timer::init(uint32_t sig_id, uint32_t sim_freq, callback_fn* fn) {
+  frequency = sim_freq;
+  cbfn = fn;
+  disable();
+}
+
+void Timer::start(uint32_t frequency) {
+  start_time = Clock::nanos();
+  setCompare(this->frequency / frequency);
+}
+
+void Timer::enable() { active = true; }
+
+void Timer::disable() { active = false; }
+
+// Like the MCU timers, the count restarts at each match and the compare
+// is measured from there. A compare already in the past fires at once.
+void Timer::setCompare(uint32_t compare) {
+  const uint64_t now = Clock::nanos();
+  this->compare = compare;
+  deadline = start_time + Clock::ticksToNanos(compare, frequency);
+  if (deadline < now) {
+    late(now - deadline);
+    deadline = now;
+  }
+}
+
+// Reading the count costs one tick, so busy-waits on it can finish
+uint32_t Timer::getCount() {
+  Clock::advance(Clock::ticksToNanos(1, frequency));
+  return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
+}
+
+void Timer::fire() {
+  const uint64_t now = Clock::nanos();
+  if (now > deadline) late(now - deadline);
+  start_time = deadline;
+  deadline += Clock::ticksToNanos(compare ? compare : 1, frequency); // Periodic unless the handler sets a new compare
+  fires++;
+  cbfn();
+}
+
+void Timer::late(uint64_t ns) {
+  overruns++;
+  late_total += ns;
+  if (ns > late_max) late_max = ns;
+}
+
+#else // !MOTION_REPLAY
+
 Timer::~Timer() {
   timer_delete(timerid);
 }
@@ -114,4 +174,6 @@ uint32_t Timer::getCount() {
   return Clock::nanosToTicks(Clock::nanos() - this->start_time, frequency);
 }
 
+#endif // !MOTION_REPLAY
+
 #endif // __PLAT_LINUX__
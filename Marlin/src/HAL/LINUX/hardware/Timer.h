@@ -52,6 +52,15 @@ public:
     return (*(intptr_t*)timerid);
   }
 
+  #ifdef MOTION_REPLAY
+    // No POSIX timer. The replay loop calls fire() once the clock reaches the deadline.
+    uint64_t getDeadline() { return deadline; }
+    uint32_t getFires() { return fires; }
+    uint64_t getLateTotal() { return late_total; }
+    uint64_t getLateMax() { return late_max; }
+    void fire();
+  #endif
+
   static void handler(int sig, siginfo_t *si, void *uc) {
     Timer* _this = (Timer*)si->si_value.sival_ptr;
     _this->avg_error += (Clock::nanos() - _this->start_time) - _this->period; //high_resolution_clock is also limited in precision, but best we have
@@ -73,4 +82,11 @@ private:
   uint64_t period;
   uint64_t avg_error;
   uint64_t start_time;
+  #ifdef MOTION_REPLAY
+    uint64_t deadline;
+    uint32_t fires;
+    uint64_t late_total;
+    uint64_t late_max;
+    void late(uint64_t ns);
+  #endif
 };
@@ -89,6 +89,12 @@ struct HalSerial {
 
   size_t write(char c) {
     if (!host_connected) return 0;
+    #ifdef MOTION_REPLAY
+      // No writer thread to drain the buffer
+      extern void replay_serial_write(const char c);
+      replay_serial_write(c);
+      return 1;
+    #endif
     while (!transmit_buffer.free());
     return transmit_buffer.write(c);
   }
@@ -20,7 +20,7 @@
  *
  */
 
-#ifdef __PLAT_LINUX__
+#if defined(__PLAT_LINUX__) && !defined(MOTION_REPLAY)
 
 //#define GPIO_LOGGING // Full GPIO and Positional Logging
 
@@ -135,4 +135,4 @@ int main() {
   read_serial.join();
 }
 
-#endif // __PLAT_LINUX__
+#endif // __PLAT_LINUX__ && !MOTION_REPLAY
@@ -0,0 +1,243 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Motion replay harness
+ *
+ * Feeds a G-code file through the serial input, queue, parser, planner and
+ * stepper with simulated time and no real-time pacing. There are no threads.
+ * This loop fires the stepper and temperature ISRs at their deadlines, and
+ * each pass of loop() or idle() costs a fixed slice of simulated time. Runs
+ * are repeatable, so planner and stepper changes can be compared on a host.
+ *
+ * Build with the linux_native_replay environment, then:
+ *
+ *   replay [-o gpio.csv] [-s serial.log] [-l loop_ns] file.gcode
+ *
+ *   -o  Log GPIO events (step, dir, enable...) with simulated timestamps (ns)
+ *   -s  Save the firmware's serial output
+ *   -l  Simulated cost of each loop() / idle() pass (default 20000ns)
+ *
+ * Heater waits and user pauses (M0 M1 M109 M116 M190 M191 M600) are skipped
+ * and cold extrusion is allowed. The heater model is too crude to wait on.
+ */
+
+#if defined(__PLAT_LINUX__) && defined(MOTION_REPLAY)
+
+#include "../../inc/MarlinConfig.h"
+#include "../../gcode/queue.h"
+#include "../../module/planner.h"
+#include "hardware/IOLoggerCSV.h"
+#include "hardware/Heater.h"
+#include "hardware/LinearAxis.h"
+#include "hardware/Timer.h"
+
+#include <chrono>
+#include <fstream>
+#include <string>
+
+extern void setup();
+extern void loop();
+extern Timer timers[2];
+
+#define REPLAY_STALL_NS 600000000000ULL // Give up after 10 simulated minutes with no progress
+
+typedef std::chrono::steady_clock host_clock;
+
+static std::ifstream gcode;
+static std::string pending;
+static size_t pending_pos;
+static bool gcode_eof;
+
+static FILE *serial_log;
+static IOLoggerCSV *gpio_log;
+static Heater *heaters[2];
+
+static uint64_t loop_ns = 20000, last_progress_ns;
+static uint32_t lines, skipped, blocks;
+static uint8_t last_tail;
+static bool in_timer;
+
+static uint32_t isr_count[2];
+static uint64_t isr_host_ns[2], isr_host_max[2];
+
+void replay_serial_write(const char c) {
+  if (serial_log) fputc(c, serial_log);
+}
+
+// Commands that wait on the heaters or the user
+static bool skip_line(const std::string &line) {
+  static const char * const waits[] = { "M0", "M1", "M109", "M116", "M190", "M191", "M600" };
+  size_t i = line.find_first_not_of(" \t");
+  if (i != std::string::npos && (line[i] == 'N' || line[i] == 'n')) { // Skip a line number
+    i = line.find_first_of(" \t", i);
+    if (i != std::string::npos) i = line.find_first_not_of(" \t", i);
+  }
+  if (i == std::string::npos) return false;
+  std::string code = line.substr(i, line.find_first_of(" \t;*\r", i) - i);
+  for (char &c : code) c = toupper(c);
+  for (const char * const w : waits) if (code == w) return true;
+  return false;
+}
+
+// Keep the serial receive buffer topped up from the file
+static void feed_serial() {
+  while (usb_serial.receive_buffer.free()) {
+    if (pending_pos >= pending.size()) {
+      if (gcode_eof || !std::getline(gcode, pending)) { gcode_eof = true; return; }
+      if (skip_line(pending)) { skipped++; pending.clear(); continue; }
+      pending += '\n';
+      pending_pos = 0;
+      lines++;
+      last_progress_ns = Clock::nanos();
+    }
+    usb_serial.receive_buffer.write(pending[pending_pos++]);
+  }
+}
+
+// Count blocks as the stepper retires them
+static void count_blocks() {
+  const uint8_t tail = planner.block_buffer_tail;
+  if (tail != last_tail) {
+    blocks += BLOCK_MOD(tail - last_tail);
+    last_tail = tail;
+    last_progress_ns = Clock::nanos();
+  }
+}
+
+/**
+ * Run the timer ISRs that fall due up to 'until', in deadline order, then move
+ * the clock there. A delay inside an ISR only moves the clock, since ISRs
+ * don't nest here.
+ */
+static void run_until(const uint64_t until) {
+  if (in_timer) return;
+  in_timer = true;
+  for (;;) {
+    uint8_t t = 0xFF;
+    LOOP_L_N(i, COUNT(timers))
+      if (timers[i].enabled() && timers[i].getDeadline() <= until && (t == 0xFF || timers[i].getDeadline() < timers[t].getDeadline()))
+        t = i;
+    if (t == 0xFF) break;
+
+    Clock::advanceTo(timers[t].getDeadline());
+    const host_clock::time_point start = host_clock::now();
+    timers[t].fire();
+    const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(host_clock::now() - start).count();
+    isr_count[t]++;
+    isr_host_ns[t] += ns;
+    NOLESS(isr_host_max[t], ns);
+    if (t == MF_TIMER_STEP) count_blocks();
+  }
+  in_timer = false;
+  Clock::advanceTo(until);
+  for (Heater *h : heaters) h->update();
+}
+
+void HAL_idletask() { run_until(Clock::nanos() + loop_ns); }
+
+static bool finished() {
+  return gcode_eof && pending_pos >= pending.size() && !usb_serial.available()
+      && !queue.has_commands_queued() && !planner.has_blocks_queued();
+}
+
+static void report_timer(const char * const name, const uint8_t t, const double host_s, const double sim_s) {
+  Timer &tm = timers[t];
+  fprintf(stderr, "%-12s %10u ISRs %12.0f /s host %10.0f /s simulated  %6.0f ns avg %8llu ns max host\n",
+    name, isr_count[t], isr_count[t] / host_s, isr_count[t] / sim_s,
+    isr_count[t] ? (double)isr_host_ns[t] / isr_count[t] : 0.0, (unsigned long long)isr_host_max[t]);
+  fprintf(stderr, "%-12s %10u late %12.0f ns avg %10llu ns max\n",
+    "", tm.getOverruns(), tm.getOverruns() ? (double)tm.getLateTotal() / tm.getOverruns() : 0.0, (unsigned long long)tm.getLateMax());
+}
+
+int main(int argc, char *argv[]) {
+  const char *gcode_name = nullptr, *gpio_name = nullptr, *serial_name = nullptr;
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg == "-o" && i + 1 < argc) gpio_name = argv[++i];
+    else if (arg == "-s" && i + 1 < argc) serial_name = argv[++i];
+    else if (arg == "-l" && i + 1 < argc) loop_ns = strtoull(argv[++i], nullptr, 10);
+    else if (!gcode_name && arg[0] != '-') gcode_name = argv[i];
+    else { gcode_name = nullptr; break; }
+  }
+  if (!gcode_name) {
+    fprintf(stderr, "Usage: %s [-o gpio.csv] [-s serial.log] [-l loop_ns] file.gcode\n", argv[0]);
+    return 1;
+  }
+
+  gcode.open(gcode_name);
+  if (!gcode) { fprintf(stderr, "Can't open %s\n", gcode_name); return 1; }
+  if (serial_name && !(serial_log = fopen(serial_name, "w"))) { fprintf(stderr, "Can't open %s\n", serial_name); return 1; }
+  if (gpio_name) {
+    gpio_log = new IOLoggerCSV(gpio_name);
+    Gpio::attachLogger(gpio_log);
+  }
+
+  Heater hotend(HEATER_0_PIN, TEMP_0_PIN), bed(HEATER_BED_PIN, TEMP_BED_PIN);
+  heaters[0] = &hotend;
+  heaters[1] = &bed;
+  LinearAxis x_axis(X_ENABLE_PIN, X_DIR_PIN, X_STEP_PIN, X_MIN_PIN, X_MAX_PIN);
+  LinearAxis y_axis(Y_ENABLE_PIN, Y_DIR_PIN, Y_STEP_PIN, Y_MIN_PIN, Y_MAX_PIN);
+  LinearAxis z_axis(Z_ENABLE_PIN, Z_DIR_PIN, Z_STEP_PIN, Z_MIN_PIN, Z_MAX_PIN);
+  LinearAxis extruder0(E0_ENABLE_PIN, E0_DIR_PIN, E0_STEP_PIN, P_NC, P_NC);
+
+  Clock::setFrequency(F_CPU);
+  Clock::setIdler(run_until);
+  HAL_timer_init();
+
+  #if ENABLED(PREVENT_COLD_EXTRUSION)
+    pending = "M302 P1\n";
+  #endif
+
+  setup();
+
+  const host_clock::time_point start = host_clock::now();
+  const uint64_t sim_start = Clock::nanos();
+  last_progress_ns = sim_start;
+  bool stalled = false;
+
+  while (!finished()) {
+    feed_serial();
+    loop();
+    run_until(Clock::nanos() + loop_ns);
+    if (gpio_log) gpio_log->flush();
+    if (Clock::nanos() - last_progress_ns > REPLAY_STALL_NS) { stalled = true; break; }
+  }
+
+  const double host_s = std::chrono::duration<double>(host_clock::now() - start).count(),
+               sim_s = (Clock::nanos() - sim_start) / 1e9;
+
+  if (serial_log) fclose(serial_log);
+  if (gpio_log) { gpio_log->flush(); delete gpio_log; }
+
+  fprintf(stderr, "%s%s\n", gcode_name, stalled ? " (stalled)" : "");
+  fprintf(stderr, "%-12s %10.3f s host %12.3f s simulated %8.1fx\n", "time", host_s, sim_s, sim_s / host_s);
+  fprintf(stderr, "%-12s %10u      %12.0f /s host (%u skipped)\n", "lines", lines, lines / host_s, skipped);
+  fprintf(stderr, "%-12s %10u      %12.0f /s host %10.1f /s simulated\n", "blocks", blocks, blocks / host_s, blocks / sim_s);
+  report_timer("stepper", MF_TIMER_STEP, host_s, sim_s);
+  report_timer("temperature", MF_TIMER_TEMP, host_s, sim_s);
+  fprintf(stderr, "%-12s X%d Y%d Z%d E%d\n", "position", x_axis.position, y_axis.position, z_axis.position, extruder0.position);
+
+  return stalled ? 2 : 0;
+}
+
+#endif // __PLAT_LINUX__ && MOTION_REPLAY
@@ -149,8 +149,10 @@ extern "C" {
 // ADC
 // ------------------------
 
-// TODO: Make sure this doesn't cause any delay
-void HAL_adc_start_conversion(const uint8_t adc_pin) { HAL_adc_result = analogRead(adc_pin); }
+#if !HAL_ADC_DMA_SCAN
+  // TODO: Make sure this doesn't cause any delay
+  void HAL_adc_start_conversion(const uint8_t adc_pin) { HAL_adc_result = analogRead(adc_pin); }
+#endif
 uint16_t HAL_adc_get_result() { return HAL_adc_result; }
 
 // Reset the system to initiate a firmware flash
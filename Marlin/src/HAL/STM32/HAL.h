@@ -185,7 +185,15 @@ static inline int freeMemory() {
 // ADC
 //
 
-#define HAL_ANALOG_SELECT(pin) pinMode(pin, INPUT)
+#if ENABLED(ADC_DMA_SCAN) && (defined(STM32F1xx) || defined(STM32F4xx))
+  #define HAL_ADC_DMA_SCAN 1
+#endif
+
+#if HAL_ADC_DMA_SCAN
+  #define HAL_ANALOG_SELECT(pin) NOOP // Pins are set up by HAL_adc_init
+#else
+  #define HAL_ANALOG_SELECT(pin) pinMode(pin, INPUT)
+#endif
 
 #ifdef ADC_RESOLUTION
   #define HAL_ADC_RESOLUTION ADC_RESOLUTION
@@ -198,7 +206,11 @@ static inline int freeMemory() {
 #define HAL_READ_ADC()      HAL_adc_result
 #define HAL_ADC_READY()     true
 
-inline void HAL_adc_init() { analogReadResolution(HAL_ADC_RESOLUTION); }
+#if HAL_ADC_DMA_SCAN
+  void HAL_adc_init();
+#else
+  inline void HAL_adc_init() { analogReadResolution(HAL_ADC_RESOLUTION); }
+#endif
 
 void HAL_adc_start_conversion(const uint8_t adc_pin);
 
@@ -0,0 +1,217 @@
+/**
+ * Marlin 3D Printer Firmware
+ *
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Scan-mode ADC1 + circular DMA for all analog inputs
+ *
+ * ADC1 converts every analog input in turn, without pause, and DMA copies the
+ * results into a ring of ADC_DMA_OVERSAMPLE rows. HAL_START_ADC only averages
+ * the column for the requested pin, so the temperature ISR never waits on the
+ * ADC and the extra samples cost no CPU time.
+ *
+ * If any input has no ADC1 channel, like the ADC3-only pins of larger F4
+ * parts, all inputs keep the blocking analogRead.
+ */
+
+#include "../platforms.h"
+
+#ifdef HAL_STM32
+
+#include "../../inc/MarlinConfig.h"
+
+#if HAL_ADC_DMA_SCAN
+
+static constexpr pin_t adc_dma_pins[] = {
+  #if HAS_TEMP_ADC_0
+    TEMP_0_PIN,
+  #endif
+  #if HAS_TEMP_ADC_PROBE
+    TEMP_PROBE_PIN,
+  #endif
+  #if HAS_TEMP_ADC_BED
+    TEMP_BED_PIN,
+  #endif
+  #if HAS_TEMP_ADC_CHAMBER
+    TEMP_CHAMBER_PIN,
+  #endif
+  #if HAS_TEMP_ADC_COOLER
+    TEMP_COOLER_PIN,
+  #endif
+  #if HAS_TEMP_ADC_BOARD
+    TEMP_BOARD_PIN,
+  #endif
+  #if HAS_TEMP_ADC_REDUNDANT
+    TEMP_REDUNDANT_PIN,
+  #endif
+  #if HAS_TEMP_ADC_1
+    TEMP_1_PIN,
+  #endif
+  #if HAS_TEMP_ADC_2
+    TEMP_2_PIN,
+  #endif
+  #if HAS_TEMP_ADC_3
+    TEMP_3_PIN,
+  #endif
+  #if HAS_TEMP_ADC_4
+    TEMP_4_PIN,
+  #endif
+  #if HAS_TEMP_ADC_5
+    TEMP_5_PIN,
+  #endif
+  #if HAS_TEMP_ADC_6
+    TEMP_6_PIN,
+  #endif
+  #if HAS_TEMP_ADC_7
+    TEMP_7_PIN,
+  #endif
+  #if ENABLED(FILAMENT_WIDTH_SENSOR)
+    FILWIDTH_PIN,
+  #endif
+  #if HAS_ADC_BUTTONS
+    ADC_KEYPAD_PIN,
+  #endif
+  #if HAS_JOY_ADC_X
+    JOY_X_PIN,
+  #endif
+  #if HAS_JOY_ADC_Y
+    JOY_Y_PIN,
+  #endif
+  #if HAS_JOY_ADC_Z
+    JOY_Z_PIN,
+  #endif
+  #if ENABLED(POWER_MONITOR_CURRENT)
+    POWER_MONITOR_CURRENT_PIN,
+  #endif
+  #if ENABLED(POWER_MONITOR_VOLTAGE)
+    POWER_MONITOR_VOLTAGE_PIN,
+  #endif
+};
+
+#define ADC_DMA_CHANNELS COUNT(adc_dma_pins)
+static_assert(ADC_DMA_CHANNELS <= 16, "ADC_DMA_SCAN supports up to 16 analog inputs.");
+
+// One row per scan of all channels, filled round-robin by DMA
+static volatile uint16_t adc_dma_buffer[ADC_DMA_OVERSAMPLE][ADC_DMA_CHANNELS];
+static bool adc_dma_active = false;             // False to read all pins with analogRead
+
+// ADC1 channel of a pin, or -1 if the pin has none
+static int8_t adc1_channel(const PinName pn) {
+  for (const PinMap *map = PinMap_ADC; map->pin != NC; map++)
+    if (map->pin == pn && map->peripheral == ADC1)
+      return STM_PIN_CHANNEL(map->function);
+  return -1;
+}
+
+void HAL_adc_init() {
+  analogReadResolution(HAL_ADC_RESOLUTION);
+
+  // Every input needs an ADC1 channel. Don't mix in analogRead, whose
+  // cleanup resets all ADCs and would stop the scan.
+  LOOP_L_N(i, ADC_DMA_CHANNELS) {
+    if (adc1_channel(digitalPinToPinName(adc_dma_pins[i])) < 0) {
+      SERIAL_ECHO_MSG("ADC_DMA_SCAN: Pin ", adc_dma_pins[i], " is not on ADC1. Using analogRead.");
+      return;
+    }
+  }
+
+  // Put the pins in analog mode and build the regular sequence
+  uint32_t sqr[3] = { 0 };
+  LOOP_L_N(i, ADC_DMA_CHANNELS) {
+    const PinName pn = digitalPinToPinName(adc_dma_pins[i]);
+    pinmap_pinout(pn, PinMap_ADC);
+    sqr[i / 6] |= uint32_t(adc1_channel(pn)) << ((i % 6) * 5);
+  }
+
+  #ifdef STM32F1xx
+
+    __HAL_RCC_ADC_CONFIG(RCC_ADCPCLK2_DIV6);    // ADCCLK <= 14MHz
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_DMA1_CLK_ENABLE();
+
+    ADC1->CR2 = 0;
+    ADC1->SMPR1 = 0x00FFFFFF;                   // 239.5 cycles on every channel
+    ADC1->SMPR2 = 0x3FFFFFFF;
+    ADC1->SQR1 = ((ADC_DMA_CHANNELS - 1) << ADC_SQR1_L_Pos) | sqr[2];
+    ADC1->SQR2 = sqr[1];
+    ADC1->SQR3 = sqr[0];
+    ADC1->CR1 = ADC_CR1_SCAN;
+
+    ADC1->CR2 = ADC_CR2_ADON;
+    delayMicroseconds(10);
+    ADC1->CR2 |= ADC_CR2_RSTCAL;
+    while (ADC1->CR2 & ADC_CR2_RSTCAL) { /* nada */ }
+    ADC1->CR2 |= ADC_CR2_CAL;
+    while (ADC1->CR2 & ADC_CR2_CAL) { /* nada */ }
+
+    // ADC1 is hard-wired to DMA1 channel 1
+    DMA1_Channel1->CCR = 0;
+    DMA1_Channel1->CPAR = (uint32_t)&ADC1->DR;
+    DMA1_Channel1->CMAR = (uint32_t)adc_dma_buffer;
+    DMA1_Channel1->CNDTR = ADC_DMA_OVERSAMPLE * ADC_DMA_CHANNELS;
+    DMA1_Channel1->CCR = DMA_CCR_PL_0 | DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_EN;
+
+    // Software trigger, then convert continuously
+    ADC1->CR2 |= ADC_CR2_CONT | ADC_CR2_DMA | ADC_CR2_EXTSEL | ADC_CR2_EXTTRIG;
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+
+  #else // STM32F4xx
+
+    __HAL_RCC_ADC1_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    // ADC1 on DMA2 stream 4, channel 0. Stream 0 belongs to the FSMC TFT.
+    DMA2_Stream4->CR = 0;
+    while (DMA2_Stream4->CR & DMA_SxCR_EN) { /* nada */ }
+    DMA2->HIFCR = DMA_HIFCR_CFEIF4 | DMA_HIFCR_CDMEIF4 | DMA_HIFCR_CTEIF4 | DMA_HIFCR_CHTIF4 | DMA_HIFCR_CTCIF4;
+    DMA2_Stream4->PAR = (uint32_t)&ADC1->DR;
+    DMA2_Stream4->M0AR = (uint32_t)adc_dma_buffer;
+    DMA2_Stream4->NDTR = ADC_DMA_OVERSAMPLE * ADC_DMA_CHANNELS;
+    DMA2_Stream4->CR = DMA_SxCR_PL_0 | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0 | DMA_SxCR_MINC | DMA_SxCR_CIRC | DMA_SxCR_EN;
+
+    ADC->CCR = (ADC->CCR & ~ADC_CCR_ADCPRE) | ADC_CCR_ADCPRE; // PCLK2 / 8
+    ADC1->CR2 = 0;
+    ADC1->SMPR1 = 0x07FFFFFF;                   // 480 cycles on every channel
+    ADC1->SMPR2 = 0x3FFFFFFF;
+    ADC1->SQR1 = ((ADC_DMA_CHANNELS - 1) << ADC_SQR1_L_Pos) | sqr[2];
+    ADC1->SQR2 = sqr[1];
+    ADC1->SQR3 = sqr[0];
+    ADC1->CR1 = ADC_CR1_SCAN;
+    ADC1->CR2 = ADC_CR2_ADON | ADC_CR2_CONT | ADC_CR2_DMA | ADC_CR2_DDS;
+    delayMicroseconds(10);
+    ADC1->CR2 |= ADC_CR2_SWSTART;
+
+  #endif
+
+  adc_dma_active = true;
+}
+
+void HAL_adc_start_conversion(const uint8_t adc_pin) {
+  if (adc_dma_active) LOOP_L_N(i, ADC_DMA_CHANNELS) {
+    if (adc_dma_pins[i] != adc_pin) continue;
+    uint32_t sum = 0;
+    for (uint16_t s = 0; s < ADC_DMA_OVERSAMPLE; s++) sum += adc_dma_buffer[s][i];
+    HAL_adc_result = (sum / (ADC_DMA_OVERSAMPLE)) >> (12 - (HAL_ADC_RESOLUTION));
+    return;
+  }
+  HAL_adc_result = analogRead(adc_pin);
+}
+
+#endif // HAL_ADC_DMA_SCAN
+#endif // HAL_STM32
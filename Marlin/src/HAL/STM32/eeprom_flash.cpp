@@ -95,6 +95,246 @@
   static_assert(IS_FLASH_SECTOR(FLASH_SECTOR), "FLASH_SECTOR is invalid");
   static_assert(IS_POWER_OF_2(FLASH_UNIT_SIZE), "FLASH_UNIT_SIZE should be a power of 2, please check your chip's spec sheet");
 
+#elif ENABLED(FLASH_EEPROM_LOG)
+
+  /**
+   * Log-structured storage for chips with small flash pages (STM32F1)
+   *
+   * Two flash pages take turns holding a log of records, each one a run of EEPROM bytes:
+   *   [uint16 address][uint16 length][data, padded to a halfword]
+   * A page starts with [LOG_MAGIC][generation] and a save appends only the runs of bytes
+   * that changed, followed by a commit record. The committed log is replayed into RAM
+   * once, on first access, and all reads come from there. When a page is full its
+   * contents are compacted into the other page and the old page is erased, so a page
+   * erase only stalls the rare save that fills a page.
+   *
+   * If there's no log yet the image of the stm32duino EEPROM page is imported.
+   */
+
+  #include "stm32_def.h"
+
+  #define DEBUG_OUT ENABLED(EEPROM_CHITCHAT)
+  #include "../../core/debug_out.h"
+
+  #ifndef EEPROM_PAGE_SIZE
+    #define EEPROM_PAGE_SIZE      FLASH_PAGE_SIZE
+  #endif
+  #ifndef EEPROM_START_ADDRESS
+    #define EEPROM_START_ADDRESS  (FLASH_BANK1_END + 1 - 2 * (EEPROM_PAGE_SIZE))
+  #endif
+  #ifndef MARLIN_EEPROM_SIZE
+    #define MARLIN_EEPROM_SIZE    EEPROM_PAGE_SIZE
+  #endif
+
+  #define LOG_PAGE_ADDRESS(p)     (EEPROM_START_ADDRESS + (p) * (EEPROM_PAGE_SIZE))
+  #define LOG_MAGIC               0x4C4DU   // Page header
+  #define LOG_COMMIT              0xFFFEU   // Address of a commit record
+  #define LOG_EMPTY               0xFFFFU   // Erased flash
+  #define LOG_HEADER              4         // Bytes in a page header or record header
+
+  #define IS_DIRTY(i)             TEST(log_dirty[(i) >> 3], (i) & 7)
+
+  static_assert(MARLIN_EEPROM_SIZE < LOG_COMMIT, "MARLIN_EEPROM_SIZE is too large for FLASH_EEPROM_LOG");
+  static_assert(0 == (EEPROM_PAGE_SIZE) % (FLASH_PAGE_SIZE), "EEPROM_PAGE_SIZE must be a multiple of FLASH_PAGE_SIZE");
+
+  static uint8_t ram_eeprom[MARLIN_EEPROM_SIZE];
+  static uint8_t log_dirty[(MARLIN_EEPROM_SIZE + 7) / 8];   // Bytes changed since the last save
+  static bool log_loaded = false,
+              log_compact = false;                         // Write a fresh page on the next save
+  static uint8_t log_page;                                 // The page holding the current log
+  static uint16_t log_generation;
+  static uint32_t log_end;                                 // Offset of the next record in log_page
+
+  inline uint16_t log_read(const uint8_t page, const uint32_t offset) {
+    return *(__IO uint16_t*)(LOG_PAGE_ADDRESS(page) + offset);
+  }
+
+  static bool log_blank(const uint8_t page, uint32_t offset) {
+    for (; offset < EEPROM_PAGE_SIZE; offset += 2)
+      if (log_read(page, offset) != LOG_EMPTY) return false;
+    return true;
+  }
+
+  // Walk the records of a page and return the offset just past the last commit, or 0 if none.
+  // With 'apply' copy the committed runs into ram_eeprom.
+  static uint32_t log_scan(const uint8_t page, const bool apply=false, const uint32_t limit=EEPROM_PAGE_SIZE) {
+    if (log_read(page, 0) != LOG_MAGIC) return 0;
+    uint32_t offset = LOG_HEADER, committed = 0;
+    while (offset + LOG_HEADER <= limit) {
+      const uint16_t addr = log_read(page, offset), len = log_read(page, offset + 2);
+      if (addr == LOG_COMMIT && len == 0) {
+        offset += LOG_HEADER;
+        committed = offset;
+        continue;
+      }
+      if (len == 0 || uint32_t(addr) + len > MARLIN_EEPROM_SIZE || offset + LOG_HEADER + len > EEPROM_PAGE_SIZE) break;
+      if (apply) memcpy(ram_eeprom + addr, (uint8_t*)(LOG_PAGE_ADDRESS(page) + offset + LOG_HEADER), len);
+      offset += LOG_HEADER + ((len + 1) & ~1U);
+    }
+    return committed;
+  }
+
+  static void log_load() {
+    const uint32_t committed[2] = { log_scan(0), log_scan(1) };
+    const uint16_t generation[2] = { log_read(0, 2), log_read(1, 2) };
+
+    memset(ram_eeprom, 0xFF, sizeof(ram_eeprom));
+    memset(log_dirty, 0, sizeof(log_dirty));
+
+    if (committed[0] || committed[1]) {
+      // Both pages are valid if a compaction was cut short. The newer one wins.
+      log_page = !committed[0] || (committed[1] && int16_t(generation[1] - generation[0]) > 0);
+      log_generation = generation[log_page];
+      log_end = committed[log_page];
+      log_scan(log_page, true, log_end);
+      // Anything after the last commit is from an interrupted save
+      log_compact = !log_blank(log_page, log_end);
+      DEBUG_ECHOLNPGM("EEPROM log page ", log_page, " generation ", log_generation, " used ", log_end);
+    }
+    else {
+      // No log yet. Start from the stm32duino EEPROM page, which is the last page.
+      // Copy it straight from flash so the core's EEPROM buffer isn't linked in.
+      if (log_read(1, 0) != LOG_MAGIC) {
+        memcpy(ram_eeprom, (const void*)LOG_PAGE_ADDRESS(1), _MIN(MARLIN_EEPROM_SIZE, EEPROM_PAGE_SIZE));
+        DEBUG_ECHOLNPGM("EEPROM log created from flash EEPROM");
+      }
+      log_page = 1;
+      log_generation = 0;
+      log_compact = true;
+    }
+
+    log_loaded = true;
+  }
+
+  static bool log_program(const uint32_t address, const uint16_t data) {
+    const HAL_StatusTypeDef status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_HALFWORD, address, data);
+    if (status != HAL_OK) {
+      DEBUG_ECHOLNPGM("HAL_FLASH_Program=", status);
+      DEBUG_ECHOLNPGM("GetError=", HAL_FLASH_GetError());
+      DEBUG_ECHOLNPGM("address=", address);
+      return false;
+    }
+    return true;
+  }
+
+  // Program a record header and its data from ram_eeprom
+  static bool log_program_record(const uint32_t address, const uint16_t addr, const uint16_t len) {
+    if (!log_program(address, addr) || !log_program(address + 2, len)) return false;
+    for (uint16_t i = 0; i < len; i += 2) {
+      const uint16_t data = ram_eeprom[addr + i] | (i + 1 < len ? ram_eeprom[addr + i + 1] << 8 : 0xFF00);
+      if (!log_program(address + LOG_HEADER + i, data)) return false;
+    }
+    return true;
+  }
+
+  static bool log_erase(const uint8_t page) {
+    FLASH_EraseInitTypeDef EraseInitStruct;
+    uint32_t PageError = 0;
+
+    EraseInitStruct.TypeErase = FLASH_TYPEERASE_PAGES;
+    EraseInitStruct.Banks = FLASH_BANK_1;
+    EraseInitStruct.PageAddress = LOG_PAGE_ADDRESS(page);
+    EraseInitStruct.NbPages = (EEPROM_PAGE_SIZE) / (FLASH_PAGE_SIZE);
+
+    TERN_(HAS_PAUSE_SERVO_OUTPUT, PAUSE_SERVO_OUTPUT());
+    DISABLE_ISRS();
+    const HAL_StatusTypeDef status = HAL_FLASHEx_Erase(&EraseInitStruct, &PageError);
+    ENABLE_ISRS();
+    TERN_(HAS_PAUSE_SERVO_OUTPUT, RESUME_SERVO_OUTPUT());
+
+    if (status != HAL_OK) {
+      DEBUG_ECHOLNPGM("HAL_FLASHEx_Erase=", status);
+      DEBUG_ECHOLNPGM("GetError=", HAL_FLASH_GetError());
+      DEBUG_ECHOLNPGM("PageError=", PageError);
+      return false;
+    }
+    return true;
+  }
+
+  // Find the next run of bytes to write, starting at 'from'. Short gaps are bridged,
+  // as they cost less than another record header. A fresh page gets all non-blank bytes.
+  static bool log_next_run(uint16_t &from, uint16_t &addr, uint16_t &len, const bool fresh) {
+    auto wanted = [&](const uint16_t i) { return fresh ? ram_eeprom[i] != 0xFF : IS_DIRTY(i); };
+    while (from < MARLIN_EEPROM_SIZE && !wanted(from)) from++;
+    if (from >= MARLIN_EEPROM_SIZE) return false;
+    addr = from;
+    uint16_t end = from + 1;
+    for (uint16_t i = end; i < MARLIN_EEPROM_SIZE && i < end + LOG_HEADER; i++)
+      if (wanted(i)) end = i + 1;
+    len = end - addr;
+    from = end;
+    return true;
+  }
+
+  // Write the changed runs and a commit at the end of the log.
+  // Return false if the runs don't fit in the page.
+  static bool log_append(bool &error) {
+    uint16_t from = 0, addr, len;
+    uint32_t need = LOG_HEADER;
+    while (log_next_run(from, addr, len, false)) need += LOG_HEADER + ((len + 1) & ~1U);
+    if (log_end + need > EEPROM_PAGE_SIZE) return false;
+
+    uint32_t address = LOG_PAGE_ADDRESS(log_page) + log_end;
+    for (from = 0; !error && log_next_run(from, addr, len, false);) {
+      error = !log_program_record(address, addr, len);
+      address += LOG_HEADER + ((len + 1) & ~1U);
+    }
+    error = error || !log_program(address, LOG_COMMIT) || !log_program(address + 2, 0);
+    if (!error) log_end += need;
+    return true;
+  }
+
+  // Write the whole image to the other page, then erase the old one
+  static bool log_rewrite() {
+    const uint8_t page = !log_page;
+    if (!log_blank(page, 0) && !log_erase(page)) return false;
+
+    const uint16_t generation = log_generation + 1;
+    const uint32_t base = LOG_PAGE_ADDRESS(page);
+    if (!log_program(base, LOG_MAGIC) || !log_program(base + 2, generation)) return false;
+
+    uint32_t offset = LOG_HEADER;
+    uint16_t from = 0, addr, len;
+    while (log_next_run(from, addr, len, true)) {
+      if (offset + 2 * (LOG_HEADER) + ((len + 1) & ~1U) > EEPROM_PAGE_SIZE) {
+        DEBUG_ECHOLNPGM("EEPROM image too large for the flash page");
+        return false;
+      }
+      if (!log_program_record(base + offset, addr, len)) return false;
+      offset += LOG_HEADER + ((len + 1) & ~1U);
+    }
+    if (!log_program(base + offset, LOG_COMMIT) || !log_program(base + offset + 2, 0)) return false;
+
+    // The new page is committed. Now the old one can go.
+    const uint8_t old_page = log_page;
+    log_page = page;
+    log_generation = generation;
+    log_end = offset + LOG_HEADER;
+    log_compact = false;
+    if (!log_erase(old_page)) DEBUG_ECHOLNPGM("EEPROM log page ", old_page, " not erased");
+
+    DEBUG_ECHOLNPGM("EEPROM log compacted to page ", log_page, " (", log_end, " bytes)");
+    return true;
+  }
+
+  static bool log_save() {
+    HAL_FLASH_Unlock();
+    __HAL_FLASH_CLEAR_FLAG(FLASH_FLAG_EOP | FLASH_FLAG_PGERR | FLASH_FLAG_WRPERR);
+
+    bool error = false;
+    const bool success = (!log_compact && log_append(error)) ? !error : log_rewrite();
+
+    HAL_FLASH_Lock();
+
+    // A failed write leaves the page in doubt. Start a fresh page next time.
+    if (success)
+      memset(log_dirty, 0, sizeof(log_dirty));
+    else
+      log_compact = true;
+
+    return success;
+  }
+
 #endif
 
 static bool eeprom_data_written = false;
@@ -138,6 +378,10 @@ bool PersistentStore::access_start() {
       eeprom_data_written = false;
     }
 
+  #elif ENABLED(FLASH_EEPROM_LOG)
+
+    if (!log_loaded) log_load();
+
   #else
     eeprom_buffer_fill();
   #endif
@@ -221,6 +465,11 @@ bool PersistentStore::access_finish() {
 
       return success;
 
+    #elif ENABLED(FLASH_EEPROM_LOG)
+
+      if (!log_save()) return false;
+      eeprom_data_written = false;
+
     #else
       // The following was written for the STM32F4 but may work with other MCUs as well.
       // Most STM32F4 flash does not allow reading from flash during erase operations.
@@ -249,6 +498,12 @@ bool PersistentStore::write_data(int &pos, const uint8_t *value, size_t size, ui
         ram_eeprom[pos] = v;
         eeprom_data_written = true;
       }
+    #elif ENABLED(FLASH_EEPROM_LOG)
+      if (v != ram_eeprom[pos]) {
+        ram_eeprom[pos] = v;
+        SBI(log_dirty[pos >> 3], pos & 7);
+        eeprom_data_written = true;
+      }
     #else
       if (v != eeprom_buffered_read_byte(pos)) {
         eeprom_buffered_write_byte(pos, v);
@@ -264,7 +519,11 @@ bool PersistentStore::write_data(int &pos, const uint8_t *value, size_t size, ui
 
 bool PersistentStore::read_data(int &pos, uint8_t *value, size_t size, uint16_t *crc, const bool writing/*=true*/) {
   do {
-    const uint8_t c = TERN(FLASH_EEPROM_LEVELING, ram_eeprom[pos], eeprom_buffered_read_byte(pos));
+    #if EITHER(FLASH_EEPROM_LEVELING, FLASH_EEPROM_LOG)
+      const uint8_t c = ram_eeprom[pos];
+    #else
+      const uint8_t c = eeprom_buffered_read_byte(pos);
+    #endif
     if (writing) *value = c;
     crc16(crc, &c, 1);
     pos++;
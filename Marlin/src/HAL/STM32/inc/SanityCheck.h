@@ -46,12 +46,28 @@
   #error "FLASH_EEPROM_LEVELING is currently only supported on STM32F4 hardware."
 #endif
 
+#if ENABLED(FLASH_EEPROM_LOG)
+  #if !defined(STM32F1xx)
+    #error "FLASH_EEPROM_LOG is currently only supported on STM32F1 hardware."
+  #elif ENABLED(FLASH_EEPROM_LEVELING)
+    #error "FLASH_EEPROM_LOG and FLASH_EEPROM_LEVELING can't be used together."
+  #endif
+#endif
+
 #if ENABLED(SERIAL_STATS_MAX_RX_QUEUED)
   #error "SERIAL_STATS_MAX_RX_QUEUED is not supported on STM32."
 #elif ENABLED(SERIAL_STATS_DROPPED_RX)
   #error "SERIAL_STATS_DROPPED_RX is not supported on STM32."
 #endif
 
+#if ENABLED(ADC_DMA_SCAN)
+  #if NOT_TARGET(STM32F1xx, STM32F4xx)
+    #error "ADC_DMA_SCAN is currently only supported on STM32F1 and STM32F4 hardware."
+  #elif !WITHIN(ADC_DMA_OVERSAMPLE, 1, 256) || (ADC_DMA_OVERSAMPLE & (ADC_DMA_OVERSAMPLE - 1))
+    #error "ADC_DMA_OVERSAMPLE must be a power of 2 from 1 to 256."
+  #endif
+#endif
+
 #if ANY(TFT_COLOR_UI, TFT_LVGL_UI, TFT_CLASSIC_UI) && NOT_TARGET(STM32H7xx, STM32F4xx, STM32F1xx)
   #error "TFT_COLOR_UI, TFT_LVGL_UI and TFT_CLASSIC_UI are currently only supported on STM32H7, STM32F4 and STM32F1 hardware."
 #endif
@@ -240,7 +240,7 @@ bool SDIO_Init() {
   return true;
 }
 
-static bool SDIO_ReadWriteBlock_DMA(uint32_t block, const uint8_t *src, uint8_t *dst) {
+static bool SDIO_ReadWriteBlock_DMA(uint32_t block, const uint8_t *src, uint8_t *dst, const uint16_t count=1) {
   if (HAL_SD_GetCardState(&hsd) != HAL_SD_CARD_TRANSFER) return false;
 
   TERN_(USE_WATCHDOG, HAL_watchdog_refresh());
@@ -254,7 +254,7 @@ static bool SDIO_ReadWriteBlock_DMA(uint32_t block, const uint8_t *src, uint8_t
   else {
     hdma_sdio.Init.Direction = DMA_PERIPH_TO_MEMORY;
     HAL_DMA_Init(&hdma_sdio);
-    ret = HAL_SD_ReadBlocks_DMA(&hsd, (uint8_t *)dst, block, 1);
+    ret = HAL_SD_ReadBlocks_DMA(&hsd, (uint8_t *)dst, block, count);
   }
 
   if (ret != HAL_OK) {
@@ -297,6 +297,18 @@ bool SDIO_WriteBlock(uint32_t block, const uint8_t *src) {
   return false;
 }
 
+// Read a run of blocks with one READ_MULTIPLE_BLOCK command and one DMA transfer
+bool SDIO_ReadBlocks(uint32_t block, uint8_t *dst, uint16_t count) {
+  // The DMA moves words, so an unaligned buffer goes block by block
+  if (count == 1 || ((uint32_t)dst & 0x03)) {
+    for (; count; count--, dst += 512) if (!SDIO_ReadBlock(block++, dst)) return false;
+    return true;
+  }
+  uint8_t retries = SDIO_READ_RETRIES;
+  while (retries--) if (SDIO_ReadWriteBlock_DMA(block, nullptr, dst, count)) return true;
+  return false;
+}
+
 bool SDIO_IsReady() {
   return hsd.State == HAL_SD_STATE_READY;
 }
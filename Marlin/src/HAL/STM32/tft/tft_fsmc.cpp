@@ -161,11 +161,16 @@ bool TFT_FSMC::isBusy() {
   return dmaEnabled;
 }
 
-void TFT_FSMC::TransmitDMA(uint32_t MemoryIncrease, uint16_t *Data, uint16_t Count) {
+void TFT_FSMC::StartDMA(uint32_t MemoryIncrease, uint16_t *Data, uint16_t Count) {
+  while (isBusy()) { /* previous WriteSequence_DMA still running */ }
   DMAtx.Init.PeriphInc = MemoryIncrease;
   HAL_DMA_Init(&DMAtx);
   DataTransferBegin();
   HAL_DMA_Start(&DMAtx, (uint32_t)Data, (uint32_t)&(LCD->RAM), Count);
+}
+
+void TFT_FSMC::TransmitDMA(uint32_t MemoryIncrease, uint16_t *Data, uint16_t Count) {
+  StartDMA(MemoryIncrease, Data, Count);
   HAL_DMA_PollForTransfer(&DMAtx, HAL_DMA_FULL_TRANSFER, HAL_MAX_DELAY);
   Abort();
 }
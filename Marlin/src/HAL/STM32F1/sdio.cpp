@@ -141,6 +141,11 @@ bool SDIO_ReadBlock(uint32_t blockAddress, uint8_t *data) {
   return false;
 }
 
+bool SDIO_ReadBlocks(uint32_t blockAddress, uint8_t *data, uint16_t count) {
+  for (; count; count--, data += 512) if (!SDIO_ReadBlock(blockAddress++, data)) return false;
+  return true;
+}
+
 uint32_t millis();
 
 bool SDIO_WriteBlock(uint32_t blockAddress, const uint8_t *data) {
@@ -93,6 +93,10 @@
   #include "feature/direct_stepping.h"
 #endif
 
+#if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+  #include "module/mks_wifi/mks_wifi_sd.h"
+#endif
+
 #if ENABLED(HOST_ACTION_COMMANDS)
   #include "feature/host_actions.h"
 #endif
@@ -859,6 +863,9 @@ void idle(bool no_stepper_sleep/*=false*/) {
   // Direct Stepping
   TERN_(DIRECT_STEPPING, page_manager.write_responses());
 
+  // Write WiFi upload data to the SD card
+  TERN_(MKS_WIFI_BACKGROUND_UPLOAD, mks_wifi_upload_idle());
+
   // Update the LVGL interface
   TERN_(HAS_TFT_LVGL_UI, LV_TASK_HANDLER());
 
@@ -39,6 +39,10 @@
         mesh_bed_leveling::index_to_xpos[GRID_MAX_POINTS_X],
         mesh_bed_leveling::index_to_ypos[GRID_MAX_POINTS_Y];
 
+  #if ENABLED(MBL_CELL_TABLE)
+    mesh_bed_leveling::cell_t mesh_bed_leveling::cells[GRID_MAX_CELLS_X][GRID_MAX_CELLS_Y];
+  #endif
+
   mesh_bed_leveling::mesh_bed_leveling() {
     LOOP_L_N(i, GRID_MAX_POINTS_X)
       index_to_xpos[i] = MESH_MIN_X + i * (MESH_X_DIST);
@@ -50,74 +54,68 @@
   void mesh_bed_leveling::reset() {
     z_offset = 0;
     ZERO(z_values);
+    TERN_(MBL_CELL_TABLE, refresh_cells());
     #if ENABLED(EXTENSIBLE_UI)
       GRID_LOOP(x, y) ExtUI::onMeshUpdate(x, y, 0);
     #endif
   }
 
+  #if ENABLED(MBL_CELL_TABLE)
+
+    /**
+     * Fit each cell with the bilinear patch through its four mesh points,
+     * so get_z() only needs a few multiply-adds and no divisions.
+     */
+    void mesh_bed_leveling::refresh_cells() {
+      LOOP_L_N(x, GRID_MAX_CELLS_X) LOOP_L_N(y, GRID_MAX_CELLS_Y) {
+        const float rdx = 1.0f / (index_to_xpos[x + 1] - index_to_xpos[x]),
+                    rdy = 1.0f / (index_to_ypos[y + 1] - index_to_ypos[y]),
+                    z00 = z_values[x][y],     z10 = z_values[x + 1][y],
+                    z01 = z_values[x][y + 1], z11 = z_values[x + 1][y + 1];
+        cells[x][y] = { z00, (z10 - z00) * rdx, (z01 - z00) * rdy, (z11 - z10 - z01 + z00) * rdx * rdy };
+      }
+    }
+
+  #endif
+
   #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
 
     /**
      * Prepare a mesh-leveled linear move in a Cartesian setup,
      * splitting the move where it crosses mesh borders.
+     *
+     * The grid lines are visited in order along the move, so each
+     * border is crossed once and the pieces are exact fractions
+     * of the whole move.
      */
-    void mesh_bed_leveling::line_to_destination(const_feedRate_t scaled_fr_mm_s, uint8_t x_splits, uint8_t y_splits) {
+    void mesh_bed_leveling::line_to_destination(const_feedRate_t scaled_fr_mm_s) {
       // Get current and destination cells for this line
-      xy_int8_t scel = cell_indexes(current_position), ecel = cell_indexes(destination);
-      NOMORE(scel.x, GRID_MAX_CELLS_X - 1);
-      NOMORE(scel.y, GRID_MAX_CELLS_Y - 1);
-      NOMORE(ecel.x, GRID_MAX_CELLS_X - 1);
-      NOMORE(ecel.y, GRID_MAX_CELLS_Y - 1);
+      xy_int8_t cel = cell_indexes(current_position);
+      const xy_int8_t ecel = cell_indexes(destination);
 
       // Start and end in the same cell? No split needed.
-      if (scel == ecel) {
-        current_position = destination;
-        line_to_current_position(scaled_fr_mm_s);
-        return;
-      }
-
-      #define MBL_SEGMENT_END(A) (current_position.A + (destination.A - current_position.A) * normalized_dist)
-
-      float normalized_dist;
-      xyze_pos_t dest;
-      const int8_t gcx = _MAX(scel.x, ecel.x), gcy = _MAX(scel.y, ecel.y);
-
-      // Crosses on the X and not already split on this X?
-      // The x_splits flags are insurance against rounding errors.
-      if (ecel.x != scel.x && TEST(x_splits, gcx)) {
-        // Split on the X grid line
-        CBI(x_splits, gcx);
-        dest = destination;
-        destination.x = index_to_xpos[gcx];
-        normalized_dist = (destination.x - current_position.x) / (dest.x - current_position.x);
-        destination.y = MBL_SEGMENT_END(y);
+      if (cel != ecel) {
+        const xyze_pos_t start = current_position;
+        const xyze_float_t dist = destination - start;
+        const int8_t sx = ecel.x > cel.x ? 1 : -1, sy = ecel.y > cel.y ? 1 : -1;
+
+        while (cel != ecel) {
+          // Fraction of the move to the next X and Y borders, if any are left
+          const float tx = cel.x != ecel.x ? (index_to_xpos[cel.x + (sx > 0)] - start.x) / dist.x : 2.0f,
+                      ty = cel.y != ecel.y ? (index_to_ypos[cel.y + (sy > 0)] - start.y) / dist.y : 2.0f,
+                      t = _MIN(tx, ty);
+
+          // Step into the next cell. Both indexes move at a corner.
+          if (tx <= t) cel.x += sx;
+          if (ty <= t) cel.y += sy;
+
+          current_position = start + dist * t;
+          line_to_current_position(scaled_fr_mm_s);
+        }
       }
-      // Crosses on the Y and not already split on this Y?
-      else if (ecel.y != scel.y && TEST(y_splits, gcy)) {
-        // Split on the Y grid line
-        CBI(y_splits, gcy);
-        dest = destination;
-        destination.y = index_to_ypos[gcy];
-        normalized_dist = (destination.y - current_position.y) / (dest.y - current_position.y);
-        destination.x = MBL_SEGMENT_END(x);
-      }
-      else {
-        // Must already have been split on these border(s)
-        // This should be a rare case.
-        current_position = destination;
-        line_to_current_position(scaled_fr_mm_s);
-        return;
-      }
-
-      destination.z = MBL_SEGMENT_END(z);
-      destination.e = MBL_SEGMENT_END(e);
-
-      // Do the split and look for more borders
-      line_to_destination(scaled_fr_mm_s, x_splits, y_splits);
 
-      // Restore destination from stack
-      destination = dest;
-      line_to_destination(scaled_fr_mm_s, x_splits, y_splits);
+      current_position = destination;
+      line_to_current_position(scaled_fr_mm_s);
     }
 
   #endif // IS_CARTESIAN && !SEGMENT_LEVELED_MOVES
@@ -45,6 +45,16 @@ public:
                index_to_xpos[GRID_MAX_POINTS_X],
                index_to_ypos[GRID_MAX_POINTS_Y];
 
+  #if ENABLED(MBL_CELL_TABLE)
+    // The bilinear surface over one cell: z + dx * u + dy * v + dxy * u * v,
+    // with u, v measured from the cell's lower-left mesh point
+    typedef struct { float z, dx, dy, dxy; } cell_t;
+    static cell_t cells[GRID_MAX_CELLS_X][GRID_MAX_CELLS_Y];
+
+    // Rebuild the cell table. Call after changing z_values.
+    static void refresh_cells();
+  #endif
+
   mesh_bed_leveling();
 
   static void report_mesh();
@@ -56,7 +66,10 @@ public:
     return false;
   }
 
-  static void set_z(const int8_t px, const int8_t py, const_float_t z) { z_values[px][py] = z; }
+  static void set_z(const int8_t px, const int8_t py, const_float_t z) {
+    z_values[px][py] = z;
+    TERN_(MBL_CELL_TABLE, refresh_cells());
+  }
 
   static void zigzag(const int8_t index, int8_t &px, int8_t &py) {
     px = index % (GRID_MAX_POINTS_X);
@@ -109,17 +122,23 @@ public:
       constexpr float factor = 1.0f;
     #endif
     const xy_int8_t ind = cell_indexes(pos);
-    const float x1 = index_to_xpos[ind.x], x2 = index_to_xpos[ind.x+1],
-                y1 = index_to_xpos[ind.y], y2 = index_to_xpos[ind.y+1],
-                z1 = calc_z0(pos.x, x1, z_values[ind.x][ind.y  ], x2, z_values[ind.x+1][ind.y  ]),
-                z2 = calc_z0(pos.x, x1, z_values[ind.x][ind.y+1], x2, z_values[ind.x+1][ind.y+1]),
-                zf = calc_z0(pos.y, y1, z1, y2, z2);
+    #if ENABLED(MBL_CELL_TABLE)
+      const cell_t &c = cells[ind.x][ind.y];
+      const float u = pos.x - index_to_xpos[ind.x], v = pos.y - index_to_ypos[ind.y],
+                  zf = c.z + u * (c.dx + v * c.dxy) + v * c.dy;
+    #else
+      const float x1 = index_to_xpos[ind.x], x2 = index_to_xpos[ind.x+1],
+                  y1 = index_to_ypos[ind.y], y2 = index_to_ypos[ind.y+1],
+                  z1 = calc_z0(pos.x, x1, z_values[ind.x][ind.y  ], x2, z_values[ind.x+1][ind.y  ]),
+                  z2 = calc_z0(pos.x, x1, z_values[ind.x][ind.y+1], x2, z_values[ind.x+1][ind.y+1]),
+                  zf = calc_z0(pos.y, y1, z1, y2, z2);
+    #endif
 
     return z_offset + zf * factor;
   }
 
   #if IS_CARTESIAN && DISABLED(SEGMENT_LEVELED_MOVES)
-    static void line_to_destination(const_feedRate_t scaled_fr_mm_s, uint8_t x_splits=0xFF, uint8_t y_splits=0xFF);
+    static void line_to_destination(const_feedRate_t scaled_fr_mm_s);
   #endif
 };
 
@@ -0,0 +1,72 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(STEPPER_ISR_PROFILING)
+
+#include "isr_profiler.h"
+
+ISRProfiler isr_profiler;
+
+isr_phase_stats_t ISRProfiler::stats[ISR_PHASE_COUNT];
+
+void ISRProfiler::reset() {
+  DISABLE_ISRS();
+  LOOP_L_N(i, ISR_PHASE_COUNT) stats[i] = {};
+  ENABLE_ISRS();
+}
+
+void ISRProfiler::report() {
+  SERIAL_ECHOLNPGM("Stepper ISR cycles (F_CPU ", uint32_t((F_CPU) / 1000000UL), "MHz)");
+  LOOP_L_N(i, ISR_PHASE_COUNT) {
+    // Copy with the ISR off, so all the numbers belong together
+    DISABLE_ISRS();
+    const isr_phase_stats_t s = stats[i];
+    ENABLE_ISRS();
+
+    switch (i) {
+      case ISR_PHASE_PULSE:    SERIAL_ECHOPGM("pulse");    break;
+      case ISR_PHASE_BLOCK:    SERIAL_ECHOPGM("block");    break;
+      #if ENABLED(LIN_ADVANCE)
+        case ISR_PHASE_ADVANCE:  SERIAL_ECHOPGM("advance");  break;
+      #endif
+      #if ENABLED(INTEGRATED_BABYSTEPPING)
+        case ISR_PHASE_BABYSTEP: SERIAL_ECHOPGM("babystep"); break;
+      #endif
+      default:                 SERIAL_ECHOPGM("total");    break;
+    }
+    if (!s.calls) { SERIAL_ECHOLNPGM(": no calls"); continue; }
+    SERIAL_ECHOLNPGM(": calls:", s.calls, " min:", s.min, " avg:", uint32_t(s.sum / s.calls), " max:", s.max);
+    SERIAL_ECHOPGM("  hist:");
+    LOOP_L_N(b, ISR_PROFILER_BUCKETS) SERIAL_ECHOPGM(" ", s.histogram[b]);
+    SERIAL_EOL();
+  }
+
+  // The worst total ISR time bounds the step rate the ISR can keep up with
+  DISABLE_ISRS();
+  const uint32_t worst = stats[ISR_PHASE_TOTAL].calls ? stats[ISR_PHASE_TOTAL].max : 0;
+  ENABLE_ISRS();
+  if (worst) SERIAL_ECHOLNPGM("Max ISR rate: ", uint32_t((F_CPU) / worst), "Hz");
+}
+
+#endif // STEPPER_ISR_PROFILING
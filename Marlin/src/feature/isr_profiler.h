@@ -0,0 +1,96 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * isr_profiler.h - Cycle counts of the Stepper ISR phases
+ *
+ * Uses the DWT cycle counter on ARM (enabled by calibrate_delay_loop)
+ * and the host clock, scaled to F_CPU, on the native builds.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if defined(__arm__) || defined(__thumb__)
+  #define ISR_PROFILER_CYCCNT (*(volatile uint32_t *)0xE0001004)
+#else
+  #include <chrono>
+#endif
+
+#define ISR_PROFILER_BUCKETS 16 // Powers of two: <2, <4, ... , >=32768 cycles
+
+enum ISRPhase : uint8_t {
+  ISR_PHASE_PULSE,
+  ISR_PHASE_BLOCK,
+  #if ENABLED(LIN_ADVANCE)
+    ISR_PHASE_ADVANCE,
+  #endif
+  #if ENABLED(INTEGRATED_BABYSTEPPING)
+    ISR_PHASE_BABYSTEP,
+  #endif
+  ISR_PHASE_TOTAL,
+  ISR_PHASE_COUNT
+};
+
+typedef struct {
+  uint32_t calls, min, max;
+  uint64_t sum;
+  uint32_t histogram[ISR_PROFILER_BUCKETS];
+} isr_phase_stats_t;
+
+class ISRProfiler {
+  private:
+    static isr_phase_stats_t stats[ISR_PHASE_COUNT];
+
+  public:
+    static inline uint32_t cycles() {
+      #ifdef ISR_PROFILER_CYCCNT
+        return ISR_PROFILER_CYCCNT;
+      #else
+        const uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        return uint32_t(ns * ((F_CPU) / 1000000UL) / 1000UL);
+      #endif
+    }
+
+    static inline void record(const ISRPhase phase, const uint32_t count) {
+      isr_phase_stats_t &s = stats[phase];
+      if (!s.calls++ || count < s.min) s.min = count;
+      NOLESS(s.max, count);
+      s.sum += count;
+      uint8_t bucket = count ? 32 - __builtin_clz(count) : 0;
+      if (bucket) bucket--;
+      NOMORE(bucket, ISR_PROFILER_BUCKETS - 1);
+      s.histogram[bucket]++;
+    }
+
+    static void reset();
+    static void report();
+};
+
+extern ISRProfiler isr_profiler;
+
+// Wrap a statement of Stepper::isr() in a cycle count measurement
+#define ISR_PROFILE(PHASE, STATEMENT) do{ \
+  const uint32_t _isr_start = ISRProfiler::cycles(); \
+  STATEMENT; \
+  ISRProfiler::record(PHASE, ISRProfiler::cycles() - _isr_start); \
+}while(0)
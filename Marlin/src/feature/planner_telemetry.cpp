@@ -0,0 +1,70 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_TELEMETRY)
+
+#include "planner_telemetry.h"
+
+PlannerTelemetry planner_telemetry;
+
+uint32_t PlannerTelemetry::calls, PlannerTelemetry::time_max;
+uint64_t PlannerTelemetry::time_sum;
+uint32_t PlannerTelemetry::visited_sum, PlannerTelemetry::replanned_sum;
+uint8_t PlannerTelemetry::visited, PlannerTelemetry::replanned,
+        PlannerTelemetry::visited_max, PlannerTelemetry::replanned_max;
+uint32_t PlannerTelemetry::depth_histogram[BLOCK_BUFFER_SIZE];
+uint32_t PlannerTelemetry::junctions, PlannerTelemetry::clamps[PLANNER_CLAMP_COUNT];
+
+// The counters are only updated from the main loop, with the planner
+void PlannerTelemetry::reset() {
+  calls = time_max = 0;
+  time_sum = 0;
+  visited_sum = replanned_sum = 0;
+  visited_max = replanned_max = 0;
+  LOOP_L_N(i, BLOCK_BUFFER_SIZE) depth_histogram[i] = 0;
+  junctions = 0;
+  LOOP_L_N(i, PLANNER_CLAMP_COUNT) clamps[i] = 0;
+}
+
+void PlannerTelemetry::report() {
+  if (calls) {
+    SERIAL_ECHOLNPGM("Recalculate calls:", calls, " avg:", uint32_t(time_sum / calls), "us max:", time_max, "us");
+    SERIAL_ECHOLNPGM("Blocks visited avg:", float(visited_sum) / calls, " max:", visited_max,
+                     " replanned avg:", float(replanned_sum) / calls, " max:", replanned_max);
+  }
+  else
+    SERIAL_ECHOLNPGM("Recalculate calls:0");
+
+  SERIAL_ECHOPGM("Queue depth:");
+  LOOP_L_N(i, BLOCK_BUFFER_SIZE) SERIAL_ECHOPGM(" ", depth_histogram[i]);
+  SERIAL_EOL();
+
+  SERIAL_ECHOLNPGM("Junctions:", junctions,
+                   " deviation:", clamps[PLANNER_CLAMP_DEVIATION],
+                   " segment:", clamps[PLANNER_CLAMP_SEGMENT],
+                   " nominal:", clamps[PLANNER_CLAMP_NOMINAL],
+                   " jerk:", clamps[PLANNER_CLAMP_JERK]);
+}
+
+#endif // PLANNER_TELEMETRY
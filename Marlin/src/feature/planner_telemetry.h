@@ -0,0 +1,81 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * planner_telemetry.h - Statistics of the planner look-ahead
+ *
+ * Time spent in Planner::recalculate(), blocks visited and replanned per
+ * call, the queue depth seen by each new block and the limits that capped
+ * the junction speeds. Sample with M982.
+ */
+
+#include "../inc/MarlinConfig.h"
+
+enum PlannerClamp : uint8_t {
+  PLANNER_CLAMP_DEVIATION,  // Junction deviation cornering limit
+  PLANNER_CLAMP_SEGMENT,    // Small segment arc limit (JD_HANDLE_SMALL_SEGMENTS)
+  PLANNER_CLAMP_NOMINAL,    // Nominal speed of one of the two blocks
+  PLANNER_CLAMP_JERK,       // Classic jerk limit
+  PLANNER_CLAMP_COUNT
+};
+
+class PlannerTelemetry {
+  private:
+    static uint32_t calls, time_max;
+    static uint64_t time_sum;
+    static uint32_t visited_sum, replanned_sum;
+    static uint8_t visited, replanned, visited_max, replanned_max;
+    static uint32_t depth_histogram[BLOCK_BUFFER_SIZE];
+    static uint32_t junctions, clamps[PLANNER_CLAMP_COUNT];
+
+  public:
+    // Called at the start and end of every Planner::recalculate()
+    static inline void begin_recalculate() { visited = replanned = 0; }
+    static inline void end_recalculate(const uint32_t us) {
+      calls++;
+      time_sum += us;
+      NOLESS(time_max, us);
+      visited_sum += visited;
+      replanned_sum += replanned;
+      NOLESS(visited_max, visited);
+      NOLESS(replanned_max, replanned);
+    }
+
+    // A block examined by the reverse pass
+    static inline void block_visited() { visited++; }
+
+    // A block trapezoid recomputed by recalculate_trapezoids()
+    static inline void block_replanned() { replanned++; }
+
+    // Blocks in the queue when a new one is added
+    static inline void queue_depth(const uint8_t depth) { depth_histogram[_MIN(depth, BLOCK_BUFFER_SIZE - 1)]++; }
+
+    // A junction between two moves and the limit that capped its speed
+    static inline void junction() { junctions++; }
+    static inline void clamp(const PlannerClamp why) { clamps[why]++; }
+
+    static void reset();
+    static void report();
+};
+
+extern PlannerTelemetry planner_telemetry;
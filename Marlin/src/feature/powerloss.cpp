@@ -313,6 +313,8 @@ void PrintJobRecovery::write() {
 
   debug(F("Write"));
 
+  if (card.isWriteLocked()) return; // The card is being written by a WiFi upload
+
   open(false);
   file.seekSet(0);
   const int16_t ret = file.write(&info, sizeof(info));
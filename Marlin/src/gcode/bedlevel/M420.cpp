@@ -75,6 +75,7 @@ void GcodeSuite::M420() {
         Z_VALUES(x, y) = 0.001 * random(-200, 200);
         TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, Z_VALUES(x, y)));
       }
+      TERN_(MBL_CELL_TABLE, mbl.refresh_cells());
       SERIAL_ECHOPGM("Simulated " STRINGIFY(GRID_MAX_POINTS_X) "x" STRINGIFY(GRID_MAX_POINTS_Y) " mesh ");
       SERIAL_ECHOPGM(" (", x_min);
       SERIAL_CHAR(','); SERIAL_ECHO(y_min);
@@ -179,6 +180,7 @@ void GcodeSuite::M420() {
               TERN_(EXTENSIBLE_UI, ExtUI::onMeshUpdate(x, y, Z_VALUES(x, y)));
             }
             TERN_(ABL_BILINEAR_SUBDIVISION, bed_level_virt_interpolate());
+            TERN_(MBL_CELL_TABLE, mbl.refresh_cells());
           }
 
         #endif
@@ -0,0 +1,81 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2022 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(INPUT_SHAPING)
+
+#include "../../gcode.h"
+#include "../../../module/stepper.h"
+
+/**
+ * M593: Get or Set Input Shaping parameters
+ *  X           Set the X axis (Default: X and Y)
+ *  Y           Set the Y axis
+ *  F<hz>       Resonant frequency. 0 to disable shaping.
+ *  D<zeta>     Damping ratio (0.0 - 0.99)
+ *  T<type>     Shaper type: 0 = ZV, 1 = ZVD, 2 = MZV, 3 = EI
+ *
+ * On COREXY / COREYX the X and Y motors share one setting.
+ *
+ * Waits for motion to end before applying the new values.
+ * With no parameters report the current settings.
+ */
+void GcodeSuite::M593() {
+  if (!parser.seen("XYFDT")) return M593_report();
+
+  const bool has_f = parser.seenval('F'), has_d = parser.seenval('D'), has_t = parser.seenval('T');
+  const float freq = parser.floatval('F');
+  if (has_f && freq < 0) { SERIAL_ECHOLNPGM("?F must be 0 (off) or more."); return; }
+  const float zeta = parser.floatval('D');
+  if (has_d && !WITHIN(zeta, 0, 0.99f)) { SERIAL_ECHOLNPGM("?D out of range (0 to 0.99)"); return; }
+  const uint8_t type = parser.byteval('T');
+  if (has_t && type >= SHAPER_COUNT) { SERIAL_ECHOLNPGM("?T must be 0 (ZV), 1 (ZVD), 2 (MZV) or 3 (EI)."); return; }
+
+  const bool seen_x = ENABLED(CORE_IS_XY) || parser.seen_test('X'),
+             seen_y = ENABLED(CORE_IS_XY) || parser.seen_test('Y');
+  LOOP_L_N(i, 2) if (i ? seen_y || !seen_x : seen_x || !seen_y) {
+    shaping_settings_t &ss = stepper.shaping_settings[i];
+    if (has_f) ss.frequency = freq;
+    if (has_d) ss.zeta = zeta;
+    if (has_t) ss.type = type;
+  }
+
+  stepper.refresh_shaping();
+}
+
+void GcodeSuite::M593_report(const bool forReplay/*=true*/) {
+  report_heading(forReplay, F(STR_INPUT_SHAPING));
+  #if CORE_IS_XY
+    const shaping_settings_t &ss = stepper.shaping_settings[0];
+    report_echo_start(forReplay);
+    SERIAL_ECHOLNPGM("  M593 F", ss.frequency, " D", ss.zeta, " T", ss.type);
+  #else
+    LOOP_L_N(i, 2) {
+      const shaping_settings_t &ss = stepper.shaping_settings[i];
+      report_echo_start(forReplay);
+      SERIAL_ECHOLNPGM("  M593 ", AS_CHAR(i ? 'Y' : 'X'), " F", ss.frequency, " D", ss.zeta, " T", ss.type);
+    }
+  #endif
+}
+
+#endif // INPUT_SHAPING
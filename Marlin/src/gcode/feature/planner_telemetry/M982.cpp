@@ -0,0 +1,45 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../../../inc/MarlinConfig.h"
+
+#if ENABLED(PLANNER_TELEMETRY)
+
+#include "../../gcode.h"
+#include "../../../feature/planner_telemetry.h"
+
+/**
+ * M982: Report planner telemetry
+ *
+ *   R : Reset the counters after the report
+ *
+ * Reports the time spent in the look-ahead recalculation, the blocks
+ * visited and replanned per call, a histogram of the queue depth seen
+ * by each new block (0 to BLOCK_BUFFER_SIZE-1) and how many junction
+ * speeds were capped by each limit.
+ */
+void GcodeSuite::M982() {
+  planner_telemetry.report();
+  if (parser.seen_test('R')) planner_telemetry.reset();
+}
+
+#endif // PLANNER_TELEMETRY
@@ -255,6 +255,7 @@
  * M554 - Get or set IP gateway. (Requires enabled Ethernet port)
  * M569 - Enable stealthChop on an axis. (Requires at least one _DRIVER_TYPE to be TMC2130/2160/2208/2209/5130/5160)
  * M575 - Change the serial baud rate. (Requires BAUD_RATE_GCODE)
+ * M593 - Get or set input shaping parameters: "M593 [X] [Y] F<hz> D<zeta> T<type>". (Requires INPUT_SHAPING)
  * M600 - Pause for filament change: "M600 X<pos> Y<pos> Z<raise> E<first_retract> L<later_retract>". (Requires ADVANCED_PAUSE_FEATURE)
  * M603 - Configure filament change: "M603 T<tool> U<unload_length> L<load_length>". (Requires ADVANCED_PAUSE_FEATURE)
  * M605 - Set Dual X-Carriage movement mode: "M605 S<mode> [X<x_offset>] [R<temp_offset>]". (Requires DUAL_X_CARRIAGE)
@@ -310,6 +311,8 @@
  *** Custom codes (can be changed to suit future G-code standards) ***
  * G425 - Calibrate using a conductive object. (Requires CALIBRATION_GCODE)
  * M928 - Start SD logging: "M928 filename.gco". Stop with M29. (Requires SDSUPPORT)
+ * M981 - Report Stepper ISR phase cycle counts. (Requires STEPPER_ISR_PROFILING)
+ * M982 - Report planner telemetry. (Requires PLANNER_TELEMETRY)
  * M993 - Backup SPI Flash to SD
  * M994 - Load a Backup from SD to SPI Flash
  * M995 - Touch screen calibration for TFT display
@@ -1055,6 +1058,11 @@ private:
     static void M575();
   #endif
 
+  #if ENABLED(INPUT_SHAPING)
+    static void M593();
+    static void M593_report(const bool forReplay=true);
+  #endif
+
   #if ENABLED(ADVANCED_PAUSE_FEATURE)
     static void M600();
     static void M603();
@@ -1172,6 +1180,14 @@ private:
     static void M951();
   #endif
 
+  #if ENABLED(STEPPER_ISR_PROFILING)
+    static void M981();
+  #endif
+
+  #if ENABLED(PLANNER_TELEMETRY)
+    static void M982();
+  #endif
+
   #if ENABLED(TOUCH_SCREEN_CALIBRATION)
     static void M995();
   #endif
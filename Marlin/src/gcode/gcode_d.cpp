@@ -33,9 +33,14 @@
 #include "../module/settings.h"
 #include "../module/temperature.h"
 #include "../libs/hex_print.h"
+#include "../libs/base64.h"
 #include "../HAL/shared/eeprom_if.h"
 #include "../HAL/shared/Delay.h"
 #include "../sd/cardreader.h"
+
+#if HAS_GRAPHICAL_TFT
+  #include "../lcd/tft/tft.h"
+#endif
 #include "../MarlinCore.h" // for kill
 
 extern void dump_delay_accuracy_check();
@@ -251,6 +256,68 @@ void GcodeSuite::D(const int16_t dcode) {
 
     #endif // SDSUPPORT
 
+    case 103: { // D103 Benchmark the thumbnail base64 decoder
+      // Check some vectors first, including padded groups and a group split between calls
+      {
+        static const struct { const char *text; const char *bin; } vectors[] = {
+          { "QUJD", "ABC" }, { "QUI=", "AB" }, { "QQ==", "A" }, { "QUJDRA==", "ABCD" }, { "; QU\n; I=", "AB" }
+        };
+        bool ok = true;
+        for (const auto &v : vectors) {
+          Base64Decoder b64;
+          uint8_t out[8];
+          const size_t len = strlen(v.text), half = len / 2;
+          size_t used, n = b64.decode((const uint8_t*)v.text, half, out, sizeof(out), &used);
+          n += b64.decode((const uint8_t*)v.text + half, len - half, out + n, sizeof(out) - n, &used);
+          if (n != strlen(v.bin) || memcmp(out, v.bin, n)) {
+            SERIAL_ECHOLNPGM("Base64 vector ", v.text, " FAILED");
+            ok = false;
+          }
+        }
+        if (ok) SERIAL_ECHOLNPGM("Base64 vectors OK");
+      }
+
+      // Text laid out like a PrusaSlicer thumbnail block: "; " + 78 characters per line
+      // S<kilobytes> of text to decode, default 1024
+      const uint32_t total = uint32_t(parser.ushortval('S', 1024)) * 1024UL;
+      __attribute__((aligned(sizeof(size_t)))) uint8_t text[81 * 6];
+      uint8_t bin[512];
+      for (uint16_t c = 0; c < COUNT(text); c++) {
+        const uint8_t col = c % 81;
+        text[c] = col == 0 ? ';' : col == 1 ? ' ' : col == 80 ? '\n'
+                : "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/"[(c * 7) & 0x3F];
+      }
+      Base64Decoder b64;
+      uint32_t done = 0, decoded = 0;
+      const uint32_t start = micros();
+      while (done < total) {
+        size_t used;
+        decoded += b64.decode(text, COUNT(text), bin, COUNT(bin), &used);
+        done += COUNT(text);
+        TERN_(USE_WATCHDOG, watchdog_refresh());
+      }
+      const uint32_t us = _MAX(micros() - start, 1UL);
+      SERIAL_ECHOLNPGM("Decoded ", done, " chars to ", decoded, " bytes in ", us, "us, ", float(done) / us, " MB/s");
+    } break;
+
+    #if HAS_GRAPHICAL_TFT
+      case 104: { // D104 Check that an unchanged TFT canvas is skipped on the second pass
+        bool queued[2];
+        tft.queue.sync();
+        tft.queue.invalidate(0, 0, 8, 8);
+        tft.queue.track_damage(true);
+        LOOP_L_N(pass, 2) {
+          tft.canvas(0, 0, 8, 8);
+          tft.set_background(COLOR_BACKGROUND);
+          tft.queue.track_damage(true); // Finish the canvas
+          queued[pass] = !tft.queue.is_empty();
+          tft.queue.sync();
+        }
+        tft.queue.track_damage(false);
+        SERIAL_ECHOLNPGM("TFT damage tracking ", queued[0] && !queued[1] ? "OK" : "FAILED");
+      } break;
+    #endif
+
     #if ENABLED(POSTMORTEM_DEBUGGING)
 
       case 451: { // Trigger all kind of faults to test exception catcher
@@ -192,6 +192,12 @@
     SERIAL_ECHOPGM("Diff:   ");
     report_all_axis_pos(diff);
 
+    #if ENABLED(ARC_SUPPORT)
+      extern uint16_t arc_segments_last;
+      extern uint32_t arc_segments_total;
+      SERIAL_ECHOLNPGM("Arc segments: ", arc_segments_last, " last, ", arc_segments_total, " total");
+    #endif
+
     TERN_(FULL_REPORT_TO_HOST_FEATURE, report_current_grblstate_moving());
   }
 
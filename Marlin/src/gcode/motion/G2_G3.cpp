@@ -48,9 +48,20 @@
   #define MIN_ARC_SEGMENT_MM MAX_ARC_SEGMENT_MM
 #endif
 
+// With a chord tolerance round the segment count up, so no chord is longer than the nominal length
+#ifdef ARC_CHORD_TOLERANCE
+  #define ARC_SEGMENTS_ROUND CEIL
+#else
+  #define ARC_SEGMENTS_ROUND FLOOR
+#endif
+
 #define ARC_LIJK_CODE(L,I,J,K)    CODE_N(SUB2(LINEAR_AXES),L,I,J,K)
 #define ARC_LIJKE_CODE(L,I,J,K,E) ARC_LIJK_CODE(L,I,J,K); CODE_ITEM_E(E)
 
+// Segments planned for the last arc and for all arcs since startup, reported by M114 D
+uint16_t arc_segments_last = 0;
+uint32_t arc_segments_total = 0;
+
 /**
  * Plan an arc in 2 dimensions, with linear motion in the other axes.
  * The arc is traced with many small linear segments according to the configuration.
@@ -181,7 +192,9 @@ void plan_arc(
 
   // Get the nominal segment length based on settings
   const float nominal_segment_mm = (
-    #if ARC_SEGMENTS_PER_SEC  // Length based on segments per second and feedrate
+    #ifdef ARC_CHORD_TOLERANCE  // Length based on radius, with the chord's sagitta (~L²/8r) held to the tolerance
+      constrain(SQRT(radius * (8 * (ARC_CHORD_TOLERANCE))), MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM)
+    #elif ARC_SEGMENTS_PER_SEC  // Length based on segments per second and feedrate
       constrain(scaled_fr_mm_s * RECIPROCAL(ARC_SEGMENTS_PER_SEC), MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM)
     #else
       MAX_ARC_SEGMENT_MM      // Length using the maximum segment size
@@ -189,13 +202,13 @@ void plan_arc(
   );
 
   // Number of whole segments based on the nominal segment length
-  const float nominal_segments = _MAX(FLOOR(flat_mm / nominal_segment_mm), min_segments);
+  const float nominal_segments = _MAX(ARC_SEGMENTS_ROUND(flat_mm / nominal_segment_mm), min_segments);
 
   // A new segment length based on the required minimum
   const float segment_mm = constrain(flat_mm / nominal_segments, MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM);
 
   // The number of whole segments in the arc, ignoring the remainder
-  uint16_t segments = FLOOR(flat_mm / segment_mm);
+  uint16_t segments = ARC_SEGMENTS_ROUND(flat_mm / segment_mm);
 
   // Are the segments now too few to reach the destination?
   const float segmented_length = segment_mm * segments;
@@ -336,6 +349,10 @@ void plan_arc(
 
   planner.buffer_line(raw, scaled_fr_mm_s, active_extruder, 0 OPTARG(SCARA_FEEDRATE_SCALING, inv_duration));
 
+  arc_segments_last = segments;
+  arc_segments_total += segments;
+  if (DEBUGGING(INFO)) SERIAL_ECHOLNPGM("Arc segments:", segments, " (", segment_mm, "mm)");
+
   #if ENABLED(AUTO_BED_LEVELING_UBL)
     ARC_LIJK_CODE(raw[axis_l] = start_L, raw.i = start_I, raw.j = start_J, raw.k = start_K);
   #endif
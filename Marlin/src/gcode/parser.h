@@ -28,6 +28,7 @@
  */
 
 #include "../inc/MarlinConfig.h"
+#include "../libs/strtonum.h"
 
 //#define DEBUG_GCODE_PARSER
 #if ENABLED(DEBUG_GCODE_PARSER)
@@ -254,29 +255,12 @@ public:
   // The value as a string
   static char* value_string() { return value_ptr; }
 
-  // Float removes 'E' to prevent scientific notation interpretation
-  static float value_float() {
-    if (value_ptr) {
-      char *e = value_ptr;
-      for (;;) {
-        const char c = *e;
-        if (c == '\0' || c == ' ') break;
-        if (c == 'E' || c == 'e') {
-          *e = '\0';
-          const float ret = strtof(value_ptr, nullptr);
-          *e = c;
-          return ret;
-        }
-        ++e;
-      }
-      return strtof(value_ptr, nullptr);
-    }
-    return 0;
-  }
+  // Float stops at 'E' so it's never taken for scientific notation
+  static float value_float() { return value_ptr ? gcode_strtof(value_ptr) : 0; }
 
   // Code value as a long or ulong
-  static int32_t value_long() { return value_ptr ? strtol(value_ptr, nullptr, 10) : 0L; }
-  static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, nullptr, 10) : 0UL; }
+  static int32_t value_long() { return value_ptr ? gcode_strtol(value_ptr) : 0L; }
+  static uint32_t value_ulong() { return value_ptr ? gcode_strtoul(value_ptr) : 0UL; }
 
   // Code value for use as time
   static millis_t value_millis() { return value_ulong(); }
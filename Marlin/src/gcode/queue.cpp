@@ -102,6 +102,13 @@ char GCodeQueue::injected_commands[64]; // = { 0 }
 void GCodeQueue::RingBuffer::commit_command(bool skip_ok
   OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
 ) {
+  #if HAS_COMMAND_RING
+    // The text was assembled at text_w. Wrap before a full line no longer fits.
+    char * const cmd = text + text_w;
+    commands[index_w].buffer = cmd;
+    text_w += strlen(cmd) + 1;
+    if (COMMAND_RING_SIZE - text_w < MAX_CMD_SIZE) text_w = 0;
+  #endif
   commands[index_w].skip_ok = skip_ok;
   TERN_(HAS_MULTI_SERIAL, commands[index_w].port = serial_ind);
   TERN_(POWER_LOSS_RECOVERY, recovery.commit_sdpos(index_w));
@@ -116,8 +123,8 @@ void GCodeQueue::RingBuffer::commit_command(bool skip_ok
 bool GCodeQueue::RingBuffer::enqueue(const char *cmd, bool skip_ok/*=true*/
   OPTARG(HAS_MULTI_SERIAL, serial_index_t serial_ind/*=-1*/)
 ) {
-  if (*cmd == ';' || length >= BUFSIZE) return false;
-  strcpy(commands[index_w].buffer, cmd);
+  if (*cmd == ';' || full()) return false;
+  strcpy(write_buffer(), cmd);
   commit_command(skip_ok OPTARG(HAS_MULTI_SERIAL, serial_ind));
   return true;
 }
@@ -311,6 +318,25 @@ void GCodeQueue::gcode_line_error(FSTR_P const ferr, const serial_index_t serial
   serial_state[serial_ind.index].count = 0;
 }
 
+#if ENABLED(BATCH_LINEAR_MOVES)
+
+  /**
+   * A G1 with only X, Y, E and F words, as slicers emit for perimeters and
+   * infill. At least one of X and Y, so it's never a retract or recover.
+   */
+  inline bool is_plain_move(const char *cmd) {
+    if (cmd[0] != 'G' || cmd[1] != '1' || cmd[2] != ' ') return false;
+    bool xy = false;
+    for (cmd += 3; *cmd; cmd++) switch (*cmd) {
+      case 'X': case 'Y': xy = true; break;
+      case 'E': case 'F': case ' ': case '.': case '-': case '0' ... '9': break;
+      default: return false;
+    }
+    return xy;
+  }
+
+#endif
+
 FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", but not "M290", etc
   const char * const m29 = strstr_P(cmd, PSTR("M29"));
   return m29 && !NUMERIC(m29[3]);
@@ -322,7 +348,7 @@ FORCE_INLINE bool is_M29(const char * const cmd) {  // matches "M29" & "M29 ", b
 #define PS_PAREN  3
 #define PS_ESC    4
 
-inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline void process_stream_char(const char c, uint8_t &sis, char * const buff, int &ind) {
 
   if (sis == PS_EOL) return;    // EOL comment or overflow
 
@@ -378,7 +404,7 @@ inline void process_stream_char(const char c, uint8_t &sis, char (&buff)[MAX_CMD
  * Handle a line being completed. For an empty line
  * keep sensor readings going and watchdog alive.
  */
-inline bool process_line_done(uint8_t &sis, char (&buff)[MAX_CMD_SIZE], int &ind) {
+inline bool process_line_done(uint8_t &sis, char * const buff, int &ind) {
   sis = PS_NORMAL;                    // "Normal" Serial Input State
   buff[ind] = '\0';                   // Of course, I'm a Terminator.
   const bool is_empty = (ind == 0);   // An empty line?
@@ -573,22 +599,22 @@ void GCodeQueue::get_serial_commands() {
       const bool card_eof = card.eof();
       if (n < 0 && !card_eof) { SERIAL_ERROR_MSG(STR_SD_ERR_READ); continue; }
 
-      CommandLine &command = ring_buffer.commands[ring_buffer.index_w];
+      char * const command = ring_buffer.write_buffer();  // Assemble the line in place
       const char sd_char = (char)n;
       const bool is_eol = ISEOL(sd_char);
       if (is_eol || card_eof) {
 
         // Reset stream state, terminate the buffer, and commit a non-empty command
         if (!is_eol && sd_count) ++sd_count;          // End of file with no newline
-        if (!process_line_done(sd_input_state, command.buffer, sd_count)) {
+        if (!process_line_done(sd_input_state, command, sd_count)) {
 
           // M808 L saves the sdpos of the next line. M808 loops to a new sdpos.
-          TERN_(GCODE_REPEAT_MARKERS, repeat.early_parse_M808(command.buffer));
+          TERN_(GCODE_REPEAT_MARKERS, repeat.early_parse_M808(command));
 
           #if DISABLED(PARK_HEAD_ON_PAUSE)
             // When M25 is non-blocking it can still suspend SD commands
             // Otherwise the M125 handler needs to know SD printing is active
-            if (command.buffer[0] == 'M' && command.buffer[1] == '2' && command.buffer[2] == '5' && !NUMERIC(command.buffer[3]))
+            if (command[0] == 'M' && command[1] == '2' && command[2] == '5' && !NUMERIC(command[3]))
               card.pauseSDPrint();
           #endif
 
@@ -602,7 +628,7 @@ void GCodeQueue::get_serial_commands() {
         if (card.eof()) card.fileHasFinished();         // Handle end of file reached
       }
       else
-        process_stream_char(sd_char, sd_input_state, command.buffer, sd_count);
+        process_stream_char(sd_char, sd_input_state, command, sd_count);
     }
   }
 
@@ -630,6 +656,30 @@ void GCodeQueue::exhaust() {
   planner.synchronize();
 }
 
+/**
+ * Dispatch the next command. With BATCH_LINEAR_MOVES the plain moves right
+ * behind a plain move are dispatched too, without a trip through idle(), and
+ * the planner plans the group at once. The caller advances past the last one.
+ */
+inline void process_next_commands() {
+  #if ENABLED(BATCH_LINEAR_MOVES)
+    GCodeQueue::RingBuffer &rb = queue.ring_buffer;
+    if (is_plain_move(rb.peek_next_command_string())) {
+      planner.begin_batch();
+      for (uint8_t n = 1;; n++) {
+        gcode.process_next_command();
+        if (n >= BATCH_LINEAR_MOVES_MAX || rb.length < 2 || TERN0(SDSUPPORT, card.flag.abort_sd_printing)) break;
+        const uint8_t next = rb.index_r + 1 < BUFSIZE ? rb.index_r + 1 : 0;
+        if (!is_plain_move(rb.commands[next].buffer)) break;
+        rb.advance_pos(rb.index_r, -1);
+      }
+      planner.end_batch();
+      return;
+    }
+  #endif
+  gcode.process_next_command();
+}
+
 /**
  * Get the next command in the queue, optionally log it to SD, then dispatch it
  */
@@ -688,11 +738,11 @@ void GCodeQueue::advance() {
       }
     }
     else
-      gcode.process_next_command();
+      process_next_commands();
 
   #else
 
-    gcode.process_next_command();
+    process_next_commands();
 
   #endif // SDSUPPORT
 
@@ -59,9 +59,18 @@ public:
    * (immediate, serial, sd card) and they are processed sequentially by
    * the main loop. The gcode.process_next_command method parses the next
    * command and hands off execution to individual handler functions.
+   *
+   * With COMMAND_RING_SIZE each command only points at its text, which is
+   * packed back-to-back with the others in a shared character ring. SD
+   * lines are assembled directly in the ring, serial lines are copied in
+   * once from their port's line accumulator.
    */
   struct CommandLine {
-    char buffer[MAX_CMD_SIZE];      //!< The command buffer
+    #if HAS_COMMAND_RING
+      char *buffer;                 //!< The command text, in the shared ring
+    #else
+      char buffer[MAX_CMD_SIZE];    //!< The command buffer
+    #endif
     bool skip_ok;                   //!< Skip sending ok when command is processed?
     #if HAS_MULTI_SERIAL
       serial_index_t port;          //!< Serial port the command was received on
@@ -77,9 +86,34 @@ public:
             index_w;                //!< Ring buffer's write position
     CommandLine commands[BUFSIZE];  //!< The ring buffer of commands
 
+    #if HAS_COMMAND_RING
+      uint16_t text_w;              //!< Where the next command text starts
+      char text[COMMAND_RING_SIZE]; //!< Command texts, packed back-to-back
+
+      /**
+       * There's room for 'cmdCount' more commands if that many whole MAX_CMD_SIZE
+       * lines fit from text_w on. Each line wraps early like commit_command does,
+       * so a line ahead of the oldest command always fits.
+       */
+      inline bool text_room(const uint8_t cmdCount=1) const {
+        if (!length) return true;
+        const uint16_t r = commands[index_r].buffer - text;
+        uint16_t w = text_w;
+        for (uint8_t n = cmdCount; n--;) {
+          if (w <= r && r - w < MAX_CMD_SIZE) return false;
+          w += MAX_CMD_SIZE;
+          if (COMMAND_RING_SIZE - w < MAX_CMD_SIZE) w = 0;
+        }
+        return true;
+      }
+    #endif
+
     inline serial_index_t command_port() const { return TERN0(HAS_MULTI_SERIAL, commands[index_r].port); }
 
-    inline void clear() { length = index_r = index_w = 0; }
+    inline void clear() { length = index_r = index_w = 0; TERN_(HAS_COMMAND_RING, text_w = 0); }
+
+    // Where the next command is assembled
+    inline char* write_buffer() { return TERN(HAS_COMMAND_RING, text + text_w, commands[index_w].buffer); }
 
     void advance_pos(uint8_t &p, const int inc) { if (++p >= BUFSIZE) p = 0; length += inc; }
 
@@ -93,7 +127,7 @@ public:
 
     void ok_to_send();
 
-    inline bool full(uint8_t cmdCount=1) const { return length > (BUFSIZE - cmdCount); }
+    inline bool full(uint8_t cmdCount=1) const { return length > (BUFSIZE - cmdCount) || TERN0(HAS_COMMAND_RING, !text_room(cmdCount)); }
 
     inline bool occupied() const { return length != 0; }
 
@@ -591,6 +591,26 @@
   #define HAS_MEDIA_SUBCALLS 1
 #endif
 
+#if ENABLED(SDSUPPORT) && SD_READ_AHEAD_BLOCKS
+  #define HAS_SD_READ_AHEAD 1
+#endif
+
+#if ENABLED(SDSUPPORT) && SD_EXTENT_CACHE
+  #define HAS_SD_EXTENT_CACHE 1
+#endif
+
+#if COMMAND_RING_SIZE
+  #define HAS_COMMAND_RING 1
+#endif
+
+#if ENABLED(SDSUPPORT) && SD_BLOCK_CACHE
+  #define HAS_SD_BLOCK_CACHE 1
+#endif
+
+#if ENABLED(SDSUPPORT) && SD_DIR_INDEX
+  #define HAS_SD_DIR_INDEX 1
+#endif
+
 #if HAS_PRINT_PROGRESS && EITHER(PRINT_PROGRESS_SHOW_DECIMALS, SHOW_REMAINING_TIME)
   #define HAS_PRINT_PROGRESS_PERMYRIAD 1
 #endif
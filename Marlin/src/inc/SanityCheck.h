@@ -1413,6 +1413,37 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "FOAMCUTTER_XYUV requires LINEAR_AXES >= 5."
 #endif
 
+/**
+ * Arc segmentation
+ */
+#if ENABLED(ARC_SUPPORT) && defined(ARC_CHORD_TOLERANCE)
+  #if defined(ARC_SEGMENTS_PER_SEC) && ARC_SEGMENTS_PER_SEC
+    #error "ARC_CHORD_TOLERANCE and ARC_SEGMENTS_PER_SEC are incompatible. Enable only one."
+  #endif
+  static_assert(ARC_CHORD_TOLERANCE > 0, "ARC_CHORD_TOLERANCE must be greater than 0.");
+#endif
+
+/**
+ * Input Shaping
+ */
+#if ENABLED(INPUT_SHAPING)
+  #if ENABLED(DIRECT_STEPPING)
+    #error "INPUT_SHAPING is not compatible with DIRECT_STEPPING."
+  #elif ENABLED(I2S_STEPPER_STREAM)
+    #error "INPUT_SHAPING is not compatible with I2S_STEPPER_STREAM."
+  #elif ENABLED(BABYSTEP_XY)
+    #error "INPUT_SHAPING is not compatible with BABYSTEP_XY."
+  #elif CORE_IS_XZ || CORE_IS_YZ || EITHER(MARKFORGED_XY, MARKFORGED_YX)
+    #error "INPUT_SHAPING requires Cartesian, COREXY or COREYX kinematics."
+  #elif !defined(SHAPING_BUFFER_SIZE) || SHAPING_BUFFER_SIZE < 16 || SHAPING_BUFFER_SIZE > 32768 || (SHAPING_BUFFER_SIZE & (SHAPING_BUFFER_SIZE - 1))
+    #error "SHAPING_BUFFER_SIZE must be a power of 2 from 16 to 32768."
+  #elif SHAPING_TYPE_X < 0 || SHAPING_TYPE_X > 3 || SHAPING_TYPE_Y < 0 || SHAPING_TYPE_Y > 3
+    #error "SHAPING_TYPE_[XY] must be 0 (ZV), 1 (ZVD), 2 (MZV) or 3 (EI)."
+  #endif
+  static_assert(SHAPING_FREQ_X >= 0 && SHAPING_FREQ_Y >= 0, "SHAPING_FREQ_[XY] must be 0 (off) or more.");
+  static_assert(WITHIN(SHAPING_ZETA_X, 0, 0.99) && WITHIN(SHAPING_ZETA_Y, 0, 0.99), "SHAPING_ZETA_[XY] must be from 0.0 to 0.99.");
+#endif
+
 /**
  * Allow only extra axis codes that do not conflict with G-code parameter names
  */
@@ -2741,6 +2772,14 @@ static_assert(Y_MAX_LENGTH >= Y_BED_SIZE, "Movement bounds (Y_MIN_POS, Y_MAX_POS
   #error "TFT_GENERIC requires either TFT_INTERFACE_FSMC or TFT_INTERFACE_SPI interface."
 #endif
 
+#if ENABLED(TFT_DOUBLE_BUFFER)
+  #if DISABLED(TFT_COLOR_UI)
+    #error "TFT_DOUBLE_BUFFER requires TFT_COLOR_UI."
+  #elif !HAS_FSMC_TFT || !defined(HAL_STM32)
+    #error "TFT_DOUBLE_BUFFER is currently only supported with an FSMC display on the STM32 HAL."
+  #endif
+#endif
+
 #if BOTH(TFT_INTERFACE_FSMC, TFT_INTERFACE_SPI)
   #error "Please enable only one of TFT_INTERFACE_SPI or TFT_INTERFACE_SPI."
 #endif
@@ -3864,6 +3903,54 @@ static_assert(_PLUS_TEST(4), "HOMING_FEEDRATE_MM_M values must be positive.");
   #endif
 #endif
 
+/**
+ * MKS WiFi compressed upload is decoded by the background upload task
+ */
+#if ENABLED(MKS_WIFI_COMPRESSED_UPLOAD) && DISABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+  #error "MKS_WIFI_COMPRESSED_UPLOAD requires MKS_WIFI_BACKGROUND_UPLOAD."
+#endif
+
+/**
+ * Stepper ISR profiling reads the DWT cycle counter or the host clock
+ */
+#if ENABLED(STEPPER_ISR_PROFILING) && defined(__AVR__)
+  #error "STEPPER_ISR_PROFILING requires an ARM Cortex-M3/M4/M7 or a native build."
+#endif
+
+/**
+ * SD read-ahead buffer, cluster map, block cache and directory index sizes
+ */
+#if HAS_SD_READ_AHEAD && !WITHIN(SD_READ_AHEAD_BLOCKS, 1, 63)
+  #error "SD_READ_AHEAD_BLOCKS must be between 1 and 63."
+#endif
+#if HAS_SD_EXTENT_CACHE && !WITHIN(SD_EXTENT_CACHE, 1, 255)
+  #error "SD_EXTENT_CACHE must be between 1 and 255."
+#endif
+#if HAS_SD_BLOCK_CACHE && !WITHIN(SD_BLOCK_CACHE, 1, 127)
+  #error "SD_BLOCK_CACHE must be between 1 and 127."
+#endif
+#if HAS_SD_DIR_INDEX && !WITHIN(SD_DIR_INDEX, 16, 4096)
+  #error "SD_DIR_INDEX must be between 16 and 4096."
+#endif
+
+/**
+ * Batched linear moves
+ */
+#if ENABLED(BATCH_LINEAR_MOVES) && !WITHIN(BATCH_LINEAR_MOVES_MAX, 2, 255)
+  #error "BATCH_LINEAR_MOVES_MAX must be between 2 and 255."
+#endif
+
+/**
+ * Packed command ring
+ */
+#if HAS_COMMAND_RING
+  #if !WITHIN(COMMAND_RING_SIZE, 2 * (MAX_CMD_SIZE), 65535)
+    #error "COMMAND_RING_SIZE must be between 2 * MAX_CMD_SIZE and 65535."
+  #elif BUFSIZE > 255
+    #error "BUFSIZE must be 255 or less."
+  #endif
+#endif
+
 // Misc. Cleanup
 #undef _TEST_PWM
 #undef _LINEAR_AXES_STR
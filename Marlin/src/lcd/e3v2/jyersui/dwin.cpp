@@ -3472,6 +3472,7 @@ void CrealityDWINClass::Menu_Item_Handler(uint8_t menu, uint8_t item, bool draw/
               Draw_Menu_Item(row, ICON_Axis, F("Microstep Up"));
             else if (Z_VALUES_ARR[mesh_conf.mesh_x][mesh_conf.mesh_y] < MAX_Z_OFFSET) {
               Z_VALUES_ARR[mesh_conf.mesh_x][mesh_conf.mesh_y] += 0.01;
+              TERN_(MBL_CELL_TABLE, mbl.refresh_cells());
               gcode.process_subcommands_now(F("M290 Z0.01"));
               planner.synchronize();
               current_position.z += 0.01f;
@@ -3484,6 +3485,7 @@ void CrealityDWINClass::Menu_Item_Handler(uint8_t menu, uint8_t item, bool draw/
               Draw_Menu_Item(row, ICON_AxisD, F("Microstep Down"));
             else if (Z_VALUES_ARR[mesh_conf.mesh_x][mesh_conf.mesh_y] > MIN_Z_OFFSET) {
               Z_VALUES_ARR[mesh_conf.mesh_x][mesh_conf.mesh_y] -= 0.01;
+              TERN_(MBL_CELL_TABLE, mbl.refresh_cells());
               gcode.process_subcommands_now(F("M290 Z-0.01"));
               planner.synchronize();
               current_position.z -= 0.01f;
@@ -4266,7 +4268,10 @@ void CrealityDWINClass::Value_Control() {
           planner.synchronize();
           break;
         case UBLMesh:     mesh_conf.manual_move(true); break;
-        case LevelManual: mesh_conf.manual_move(selection == LEVELING_M_OFFSET); break;
+        case LevelManual:
+          TERN_(MBL_CELL_TABLE, if (selection == LEVELING_M_OFFSET) mbl.refresh_cells());
+          mesh_conf.manual_move(selection == LEVELING_M_OFFSET);
+          break;
       #endif
     }
     if (valuepointer == &planner.flow_percentage[0])
@@ -379,6 +379,13 @@ namespace Language_en {
   LSTR MSG_A_TRAVEL                       = _UxGT("Travel Accel");
   LSTR MSG_XY_FREQUENCY_LIMIT             = _UxGT("XY Freq Limit");
   LSTR MSG_XY_FREQUENCY_FEEDRATE          = _UxGT("Min FR Factor");
+  LSTR MSG_INPUT_SHAPING                  = _UxGT("Input Shaping");
+  LSTR MSG_SHAPING_X_FREQ                 = STR_X _UxGT(" Frequency");
+  LSTR MSG_SHAPING_Y_FREQ                 = STR_Y _UxGT(" Frequency");
+  LSTR MSG_SHAPING_X_ZETA                 = STR_X _UxGT(" Damping");
+  LSTR MSG_SHAPING_Y_ZETA                 = STR_Y _UxGT(" Damping");
+  LSTR MSG_SHAPING_X_TYPE                 = STR_X _UxGT(" Shaper Type");
+  LSTR MSG_SHAPING_Y_TYPE                 = STR_Y _UxGT(" Shaper Type");
   LSTR MSG_STEPS_PER_MM                   = _UxGT("Steps/mm");
   LSTR MSG_A_STEPS                        = STR_A _UxGT(" Steps/mm");
   LSTR MSG_B_STEPS                        = STR_B _UxGT(" Steps/mm");
@@ -437,6 +437,13 @@ namespace Language_ru {
   LSTR  MSG_A_TRAVEL                        = _UxGT("Ускор.перемещ.");
   LSTR  MSG_XY_FREQUENCY_LIMIT              = _UxGT("Макс.частота.");
   LSTR  MSG_XY_FREQUENCY_FEEDRATE           = _UxGT("Мин.подача.");
+  LSTR  MSG_INPUT_SHAPING                   = _UxGT("Подавление резонанса");
+  LSTR  MSG_SHAPING_X_FREQ                  = STR_X _UxGT(" частота");
+  LSTR  MSG_SHAPING_Y_FREQ                  = STR_Y _UxGT(" частота");
+  LSTR  MSG_SHAPING_X_ZETA                  = STR_X _UxGT(" затухание");
+  LSTR  MSG_SHAPING_Y_ZETA                  = STR_Y _UxGT(" затухание");
+  LSTR  MSG_SHAPING_X_TYPE                  = STR_X _UxGT(" тип фильтра");
+  LSTR  MSG_SHAPING_Y_TYPE                  = STR_Y _UxGT(" тип фильтра");
   LSTR  MSG_STEPS_PER_MM                    = _UxGT("Шагов/мм");
   LSTR  MSG_A_STEPS                         = STR_A _UxGT(" шаг/мм");
   LSTR  MSG_B_STEPS                         = STR_B _UxGT(" шаг/мм");
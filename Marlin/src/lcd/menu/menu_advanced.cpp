@@ -34,6 +34,10 @@
 
 #include "../../module/endstops.h"
 
+#if ENABLED(RS_ADDSETTINGS)
+  #include "../../module/stepper.h"
+#endif
+
 #if DISABLED(NO_VOLUMETRICS)
   #include "../../gcode/parser.h"
 #endif
@@ -276,6 +280,7 @@ void menu_backlash();
       {
         thermistors_data.bed_type = type;
       }
+      TERN_(THERMISTOR_LUT, thermalManager.refresh_thermistor_luts());
       ui.goto_previous_screen();
     }
 
@@ -658,6 +663,31 @@ void menu_advanced_steps_per_mm() {
   END_MENU();
 }
 
+#if BOTH(INPUT_SHAPING, SHAPING_MENU)
+
+  #include "../../module/stepper.h"
+  #include "../../gcode/queue.h"
+
+  // M593 - Input Shaping
+  void menu_advanced_input_shaping() {
+    START_MENU();
+    BACK_ITEM(MSG_ADVANCED_SETTINGS);
+
+    // Applied by M593 once motion ends
+    #define EDIT_SHAPING(Q, I) \
+      EDIT_ITEM_FAST(float51, MSG_SHAPING_##Q##_FREQ, &stepper.shaping_settings[I].frequency, 0, 200, []{ queue.inject(F("M593 " #Q)); }); \
+      EDIT_ITEM_FAST(float42_52, MSG_SHAPING_##Q##_ZETA, &stepper.shaping_settings[I].zeta, 0, 0.99f, []{ queue.inject(F("M593 " #Q)); }); \
+      EDIT_ITEM(uint8, MSG_SHAPING_##Q##_TYPE, &stepper.shaping_settings[I].type, 0, SHAPER_COUNT - 1, []{ queue.inject(F("M593 " #Q)); })
+    EDIT_SHAPING(X, 0);
+    #if !CORE_IS_XY // Both motors use the X values
+      EDIT_SHAPING(Y, 1);
+    #endif
+
+    END_MENU();
+  }
+
+#endif
+
 void menu_advanced_settings() {
   const bool is_busy = printer_busy();
 
@@ -703,6 +733,11 @@ void menu_advanced_settings() {
   if (!is_busy)
     SUBMENU(MSG_STEPS_PER_MM, menu_advanced_steps_per_mm);
 
+  #if BOTH(INPUT_SHAPING, SHAPING_MENU)
+    // M593 - Input Shaping
+    if (!is_busy) SUBMENU(MSG_INPUT_SHAPING, menu_advanced_input_shaping);
+  #endif
+
   #if ENABLED(RS_ADDSETTINGS)
     SUBMENU(MSG_AXIS_DIRECTION, menu_advanced_axesdir);
     SUBMENU(MSG_ENDSTOP_INVERTING, menu_advanced_endstop_inverting);
@@ -783,11 +818,11 @@ void menu_advanced_settings() {
     START_MENU();
     // BACK_ITEM(MSG_ADVANCED_SETTINGS);
 
-    EDIT_ITEM(bool, MSG_X_INVERT, &planner.invert_axis.invert_axis[X_AXIS]);
-    EDIT_ITEM(bool, MSG_Y_INVERT, &planner.invert_axis.invert_axis[Y_AXIS]);
-    EDIT_ITEM(bool, MSG_Z1_INVERT, &planner.invert_axis.invert_axis[Z_AXIS]);
+    EDIT_ITEM(bool, MSG_X_INVERT, &planner.invert_axis.invert_axis[X_AXIS], stepper.refresh_dir_levels);
+    EDIT_ITEM(bool, MSG_Y_INVERT, &planner.invert_axis.invert_axis[Y_AXIS], stepper.refresh_dir_levels);
+    EDIT_ITEM(bool, MSG_Z1_INVERT, &planner.invert_axis.invert_axis[Z_AXIS], stepper.refresh_dir_levels);
     EDIT_ITEM(bool, MSG_Z2_INVERT, &planner.invert_axis.z2_vs_z_dir);
-    EDIT_ITEM(bool, MSG_E_INVERT, &planner.invert_axis.invert_axis[E0_AXIS]);
+    EDIT_ITEM(bool, MSG_E_INVERT, &planner.invert_axis.invert_axis[E0_AXIS], stepper.refresh_dir_levels);
 
     END_MENU();
   }
@@ -799,28 +834,28 @@ void menu_advanced_settings() {
     // BACK_ITEM(MSG_ADVANCED_SETTINGS);
 
     #if HAS_X_MIN
-      EDIT_ITEM(bool, MSG_X_MIN_INVERTING, &endstop_settings.X_MIN_INVERTING);
+      EDIT_ITEM(bool, MSG_X_MIN_INVERTING, &endstop_settings.X_MIN_INVERTING, endstops.refresh_inverting);
     #endif
     #if HAS_X_MAX
-      EDIT_ITEM(bool, MSG_X_MAX_INVERTING, &endstop_settings.X_MAX_INVERTING);
+      EDIT_ITEM(bool, MSG_X_MAX_INVERTING, &endstop_settings.X_MAX_INVERTING, endstops.refresh_inverting);
     #endif
     #if HAS_Y_MIN
-      EDIT_ITEM(bool, MSG_Y_MIN_INVERTING, &endstop_settings.Y_MIN_INVERTING);
+      EDIT_ITEM(bool, MSG_Y_MIN_INVERTING, &endstop_settings.Y_MIN_INVERTING, endstops.refresh_inverting);
     #endif
     #if HAS_Y_MAX
-      EDIT_ITEM(bool, MSG_Y_MAX_INVERTING, &endstop_settings.Y_MAX_INVERTING);
+      EDIT_ITEM(bool, MSG_Y_MAX_INVERTING, &endstop_settings.Y_MAX_INVERTING, endstops.refresh_inverting);
     #endif
     #if HAS_Z_MIN
-      EDIT_ITEM(bool, MSG_Z_MIN_INVERTING, &endstop_settings.Z_MIN_INVERTING);
+      EDIT_ITEM(bool, MSG_Z_MIN_INVERTING, &endstop_settings.Z_MIN_INVERTING, endstops.refresh_inverting);
     #endif
     #if HAS_Z_MAX
-      EDIT_ITEM(bool, MSG_Z_MAX_INVERTING, &endstop_settings.Z_MAX_INVERTING);
+      EDIT_ITEM(bool, MSG_Z_MAX_INVERTING, &endstop_settings.Z_MAX_INVERTING, endstops.refresh_inverting);
     #endif
     #if HAS_Z2_MIN
-      EDIT_ITEM(bool, MSG_Z2_MIN_INVERTING, &endstop_settings.Z2_MIN_INVERTING);
+      EDIT_ITEM(bool, MSG_Z2_MIN_INVERTING, &endstop_settings.Z2_MIN_INVERTING, endstops.refresh_inverting);
     #endif
     #if HAS_Z2_MAX
-      EDIT_ITEM(bool, MSG_Z2_MAX_INVERTING, &endstop_settings.Z2_MAX_INVERTING);
+      EDIT_ITEM(bool, MSG_Z2_MAX_INVERTING, &endstop_settings.Z2_MAX_INVERTING, endstops.refresh_inverting);
     #endif
 
     END_MENU();
@@ -204,6 +204,7 @@
 #if ENABLED(MESH_EDIT_MENU)
 
   inline void refresh_planner() {
+    TERN_(MBL_CELL_TABLE, mbl.refresh_cells());
     set_current_from_steppers_for_axis(ALL_AXES_ENUM);
     sync_plan_position();
   }
@@ -36,17 +36,24 @@ void CANVAS::New(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
   CANVAS::height = height;
   startLine = 0;
   endLine = 0;
+  buffer = TFT::buffer;
 
   tft.set_window(x, y, x + width - 1, y + height - 1);
 }
 
 void CANVAS::Continue() {
   startLine = endLine;
-  endLine = TFT_BUFFER_SIZE < width * (height - startLine) ? startLine + TFT_BUFFER_SIZE / width : height;
+  endLine = CANVAS_BUFFER_SIZE < width * (height - startLine) ? startLine + CANVAS_BUFFER_SIZE / width : height;
 }
 
 bool CANVAS::ToScreen() {
-  tft.write_sequence(buffer, width * (endLine - startLine));
+  #if ENABLED(TFT_DOUBLE_BUFFER)
+    // DMA reads this half while the next strip is composed in the other one
+    tft.write_sequence_async(buffer, width * (endLine - startLine));
+    buffer = buffer == TFT::buffer ? TFT::buffer + CANVAS_BUFFER_SIZE : TFT::buffer;
+  #else
+    tft.write_sequence(buffer, width * (endLine - startLine));
+  #endif
   return endLine == height;
 }
 
@@ -28,6 +28,9 @@
 
 #include "../../inc/MarlinConfig.h"
 
+// With TFT_DOUBLE_BUFFER two strips share TFT::buffer, even size keeps SetBackground inside its half
+#define CANVAS_BUFFER_SIZE TERN(TFT_DOUBLE_BUFFER, ((TFT_BUFFER_SIZE / 4) * 2), TFT_BUFFER_SIZE)
+
 class CANVAS {
   private:
     static uint16_t width, height;
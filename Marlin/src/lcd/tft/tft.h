@@ -89,10 +89,15 @@ class TFT {
     static inline void abort() { io.Abort(); }
     static inline void write_multiple(uint16_t Data, uint16_t Count) { io.WriteMultiple(Data, Count); }
     static inline void write_sequence(uint16_t *Data, uint16_t Count) { io.WriteSequence(Data, Count); }
-    static inline void set_window(uint16_t Xmin, uint16_t Ymin, uint16_t Xmax, uint16_t Ymax) { io.set_window(Xmin, Ymin, Xmax, Ymax); }
+    static inline void write_sequence_async(uint16_t *Data, uint16_t Count) { TERN(TFT_DOUBLE_BUFFER, io.WriteSequence_DMA(Data, Count), io.WriteSequence(Data, Count)); }
+    static inline void set_window(uint16_t Xmin, uint16_t Ymin, uint16_t Xmax, uint16_t Ymax) {
+      TERN_(TFT_DOUBLE_BUFFER, while (is_busy()) { /* wait for the canvas strip in flight */ });
+      io.set_window(Xmin, Ymin, Xmax, Ymax);
+    }
 
     static inline void fill(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) { queue.fill(x, y, width, height, color); }
     static inline void canvas(uint16_t x, uint16_t y, uint16_t width, uint16_t height) { queue.canvas(x, y, width, height); }
+    static inline void callback(taskCallback_t callback) { queue.callback(callback); }
     static inline void set_background(uint16_t color) { queue.set_background(color); }
     static inline void add_text(uint16_t x, uint16_t y, uint16_t color, TFT_String tft_string, uint16_t maxWidth = 0) { queue.add_text(x, y, color, tft_string.string(), maxWidth); }
     static inline void add_text(uint16_t x, uint16_t y, uint16_t color, const char *string, uint16_t maxWidth = 0) { queue.add_text(x, y, color, (uint8_t *)string, maxWidth); }
@@ -34,6 +34,11 @@ uint8_t *TFT_Queue::current_task = nullptr;
 uint8_t *TFT_Queue::last_task = nullptr;
 uint8_t *TFT_Queue::last_parameter = nullptr;
 
+bool TFT_Queue::damage_tracking = false;
+uint32_t TFT_Queue::sketch_hash;
+uint8_t TFT_Queue::damage_next = 0;
+damageSlot_t TFT_Queue::damage[];
+
 void TFT_Queue::reset() {
   tft.abort();
 
@@ -61,6 +66,7 @@ void TFT_Queue::async() {
     case TASK_END_OF_QUEUE: reset();      break;
     case TASK_FILL:         fill(task);   break;
     case TASK_CANVAS:       canvas(task); break;
+    case TASK_CALLBACK:     callback(task); break;
   }
 }
 
@@ -69,6 +75,15 @@ void TFT_Queue::finish_sketch() {
   queueTask_t *task = (queueTask_t *)last_task;
 
   if (task->state == TASK_STATE_SKETCH) {
+    if (!is_damaged((parametersCanvas_t *)(last_task + sizeof(queueTask_t)))) {
+      // Nothing changed in this area, take the canvas back out of the queue
+      end_of_queue = last_task;
+      *end_of_queue = TASK_END_OF_QUEUE;
+      if (current_task == last_task) current_task = nullptr;
+      last_task = nullptr;
+      return;
+    }
+
     *end_of_queue = TASK_END_OF_QUEUE;
     task->nextTask = end_of_queue;
     task->state = TASK_STATE_READY;
@@ -77,6 +92,56 @@ void TFT_Queue::finish_sketch() {
   }
 }
 
+void TFT_Queue::track_damage(const bool enable) {
+  finish_sketch(); // The last canvas is checked in the mode it was drawn in
+  damage_tracking = enable;
+}
+
+void TFT_Queue::hash(const void *data, uint16_t size) {
+  // FNV-1a
+  const uint8_t *byte = (const uint8_t *)data;
+  while (size--) sketch_hash = (sketch_hash ^ *byte++) * 16777619UL;
+}
+
+void TFT_Queue::invalidate(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+  for (uint8_t i = 0; i < TFT_DAMAGE_SLOTS; i++) {
+    damageSlot_t *slot = &damage[i];
+    if (slot->x < x + width && x < slot->x + slot->width && slot->y < y + height && y < slot->y + slot->height)
+      slot->width = slot->height = 0;
+  }
+}
+
+bool TFT_Queue::is_damaged(parametersCanvas_t *canvas) {
+  if (!damage_tracking) {
+    // Drawn over by a canvas that isn't tracked
+    invalidate(canvas->x, canvas->y, canvas->width, canvas->height);
+    return true;
+  }
+
+  damageSlot_t *slot = nullptr;
+  for (uint8_t i = 0; i < TFT_DAMAGE_SLOTS; i++) {
+    if (damage[i].x == canvas->x && damage[i].y == canvas->y && damage[i].width == canvas->width && damage[i].height == canvas->height) {
+      if (damage[i].hash == sketch_hash) return false;
+      slot = &damage[i];
+      break;
+    }
+  }
+
+  // The canvas will be drawn, over anything else in its area
+  invalidate(canvas->x, canvas->y, canvas->width, canvas->height);
+
+  if (!slot) {
+    slot = &damage[damage_next];
+    if (++damage_next >= TFT_DAMAGE_SLOTS) damage_next = 0;
+  }
+  slot->x = canvas->x;
+  slot->y = canvas->y;
+  slot->width = canvas->width;
+  slot->height = canvas->height;
+  slot->hash = sketch_hash;
+  return true;
+}
+
 void TFT_Queue::fill(queueTask_t *task) {
   uint16_t count;
   parametersFill_t *task_parameters = (parametersFill_t *)(((uint8_t *)task) + sizeof(queueTask_t));
@@ -102,13 +167,24 @@ void TFT_Queue::fill(queueTask_t *task) {
 void TFT_Queue::canvas(queueTask_t *task) {
   parametersCanvas_t *task_parameters = (parametersCanvas_t *)(((uint8_t *)task) + sizeof(queueTask_t));
 
-  uint16_t i;
-  uint8_t *item = ((uint8_t *)task_parameters) + sizeof(parametersCanvas_t);
-
   if (task->state == TASK_STATE_READY) {
     task->state = TASK_STATE_IN_PROGRESS;
     Canvas.New(task_parameters->x, task_parameters->y, task_parameters->width, task_parameters->height);
+    canvas_compose(task_parameters);
   }
+  else if (DISABLED(TFT_DOUBLE_BUFFER))
+    canvas_compose(task_parameters);
+
+  if (Canvas.ToScreen())
+    task->state = TASK_STATE_COMPLETED;
+  else if (ENABLED(TFT_DOUBLE_BUFFER))
+    canvas_compose(task_parameters); // Prepare the next strip while DMA sends this one
+}
+
+void TFT_Queue::canvas_compose(parametersCanvas_t *task_parameters) {
+  uint16_t i;
+  uint8_t *item = ((uint8_t *)task_parameters) + sizeof(parametersCanvas_t);
+
   Canvas.Continue();
 
   for (i = 0; i < task_parameters->count; i++) {
@@ -138,12 +214,19 @@ void TFT_Queue::canvas(queueTask_t *task) {
     }
     item = ((parametersCanvasBackground_t *)item)->nextParameter;
   }
+}
+
+void TFT_Queue::callback(queueTask_t *task) {
+  parametersCallback_t *task_parameters = (parametersCallback_t *)(((uint8_t *)task) + sizeof(queueTask_t));
 
-  if (Canvas.ToScreen()) task->state = TASK_STATE_COMPLETED;
+  // Completed before the call, so the callback may queue new tasks
+  task->state = TASK_STATE_COMPLETED;
+  task_parameters->callback();
 }
 
 void TFT_Queue::fill(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color) {
   finish_sketch();
+  invalidate(x, y, width, height);
 
   queueTask_t *task = (queueTask_t *)end_of_queue;
   last_task = (uint8_t *)task;
@@ -189,6 +272,30 @@ void TFT_Queue::canvas(uint16_t x, uint16_t y, uint16_t width, uint16_t height)
   task_parameters->height = height;
   task_parameters->count = 0;
 
+  sketch_hash = 2166136261UL;
+  hash(task_parameters, sizeof(parametersCanvas_t));
+
+  if (!current_task) current_task = (uint8_t *)task;
+}
+
+void TFT_Queue::callback(taskCallback_t callback) {
+  finish_sketch();
+
+  queueTask_t *task = (queueTask_t *)end_of_queue;
+  last_task = (uint8_t *)task;
+
+  end_of_queue += sizeof(queueTask_t);
+  parametersCallback_t *task_parameters = (parametersCallback_t *)end_of_queue;
+  end_of_queue += sizeof(parametersCallback_t);
+
+  last_parameter = end_of_queue;
+  task_parameters->callback = callback;
+
+  *end_of_queue = TASK_END_OF_QUEUE;
+  task->nextTask = end_of_queue;
+  task->state = TASK_STATE_READY;
+  task->type = TASK_CALLBACK;
+
   if (!current_task) current_task = (uint8_t *)task;
 }
 
@@ -200,6 +307,7 @@ void TFT_Queue::set_background(uint16_t color) {
 
   parameters->type = CANVAS_SET_BACKGROUND;
   parameters->color = ENDIAN_COLOR(color);
+  hash(&parameters->color, sizeof(parameters->color));
 
   end_of_queue += sizeof(parametersCanvasBackground_t);
   task_parameters->count++;
@@ -233,8 +341,11 @@ void TFT_Queue::add_text(uint16_t x, uint16_t y, uint16_t color, uint8_t *string
 
   end_of_queue += sizeof(parametersCanvasText_t);
 
+  hash(&parameters->x, sizeof(parametersCanvasText_t) - offsetof(parametersCanvasText_t, x));
+
   /* TODO: Deal with maxWidth */
   while ((*(end_of_queue++) = *pointer++) != 0x00);
+  hash(string, pointer - string);
 
   parameters->nextParameter = end_of_queue;
   parameters->stringLength = pointer - string;
@@ -251,6 +362,7 @@ void TFT_Queue::add_image(int16_t x, int16_t y, MarlinImage image, uint16_t *col
   parameters->x = x;
   parameters->y = y;
   parameters->image = image;
+  hash(&parameters->x, sizeof(parametersCanvasImage_t) - offsetof(parametersCanvasImage_t, x));
 
   end_of_queue += sizeof(parametersCanvasImage_t);
   task_parameters->count++;
@@ -276,6 +388,7 @@ void TFT_Queue::add_image(int16_t x, int16_t y, MarlinImage image, uint16_t *col
     *color++ = ENDIAN_COLOR(tmp);
   }
 
+  hash(parameters->nextParameter, (uint8_t *)color - parameters->nextParameter);
   end_of_queue = (uint8_t *)color;
   parameters->nextParameter = end_of_queue;
 }
@@ -328,6 +441,7 @@ void TFT_Queue::add_bar(uint16_t x, uint16_t y, uint16_t width, uint16_t height,
   parameters->width = width;
   parameters->height = height;
   parameters->color = ENDIAN_COLOR(color);
+  hash(&parameters->x, sizeof(parametersCanvasBar_t) - offsetof(parametersCanvasBar_t, x));
 
   end_of_queue += sizeof(parametersCanvasBar_t);
   task_parameters->count++;
@@ -346,6 +460,7 @@ void TFT_Queue::add_rectangle(uint16_t x, uint16_t y, uint16_t width, uint16_t h
   parameters->width = width;
   parameters->height = height;
   parameters->color = ENDIAN_COLOR(color);
+  hash(&parameters->x, sizeof(parametersCanvasRectangle_t) - offsetof(parametersCanvasRectangle_t, x));
 
   end_of_queue += sizeof(parametersCanvasRectangle_t);
   task_parameters->count++;
@@ -29,10 +29,15 @@
   #define TFT_QUEUE_SIZE              8192
 #endif
 
+#ifndef TFT_DAMAGE_SLOTS
+  #define TFT_DAMAGE_SLOTS            24
+#endif
+
 enum QueueTaskType : uint8_t {
   TASK_END_OF_QUEUE = 0x00,
   TASK_FILL,
   TASK_CANVAS,
+  TASK_CALLBACK,
 };
 
 enum QueueTaskState : uint8_t {
@@ -50,6 +55,8 @@ enum CanvasSubtype : uint8_t {
   CANVAS_ADD_RECTANGLE,
 };
 
+typedef void (*taskCallback_t)();
+
 typedef struct __attribute__((__packed__)) {
   QueueTaskType type;
   QueueTaskState state;
@@ -73,6 +80,10 @@ typedef struct __attribute__((__packed__)) {
   uint32_t count;
 } parametersCanvas_t;
 
+typedef struct __attribute__((__packed__)) {
+  taskCallback_t callback;
+} parametersCallback_t;
+
 typedef struct __attribute__((__packed__)) {
   CanvasSubtype type;
   uint8_t *nextParameter;
@@ -119,6 +130,15 @@ typedef struct __attribute__((__packed__)) {
   uint16_t color;
 } parametersCanvasRectangle_t;
 
+// Last content hash drawn into a canvas area, used to skip unchanged canvases
+typedef struct {
+  uint16_t x;
+  uint16_t y;
+  uint16_t width;
+  uint16_t height;
+  uint32_t hash;
+} damageSlot_t;
+
 class TFT_Queue {
   private:
     static uint8_t queue[TFT_QUEUE_SIZE];
@@ -127,9 +147,19 @@ class TFT_Queue {
     static uint8_t *last_task;
     static uint8_t *last_parameter;
 
+    static bool damage_tracking;
+    static uint32_t sketch_hash;
+    static uint8_t damage_next;
+    static damageSlot_t damage[TFT_DAMAGE_SLOTS];
+
+    static void hash(const void *data, uint16_t size);
+    static bool is_damaged(parametersCanvas_t *canvas);
+
     static void finish_sketch();
     static void fill(queueTask_t *task);
     static void canvas(queueTask_t *task);
+    static void canvas_compose(parametersCanvas_t *task_parameters);
+    static void callback(queueTask_t *task);
     static void handle_queue_overflow(uint16_t sizeNeeded);
 
   public:
@@ -137,8 +167,16 @@ class TFT_Queue {
     static void async();
     static void sync() { while (current_task != nullptr) async(); }
 
+    // Drop queued canvases whose area already shows the same content
+    static void track_damage(const bool enable);
+    static void damage_reset() { memset(damage, 0, sizeof(damage)); }
+    // Forget tracked canvases in an area drawn without the queue
+    static void invalidate(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+    static bool is_empty() { return current_task == nullptr; }
+
     static void fill(uint16_t x, uint16_t y, uint16_t width, uint16_t height, uint16_t color);
     static void canvas(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+    static void callback(taskCallback_t callback);
     static void set_background(uint16_t color);
     static void add_text(uint16_t x, uint16_t y, uint16_t color, uint8_t *string, uint16_t maxWidth);
 
@@ -344,6 +344,8 @@ void MarlinUI::draw_status_screen() {
   #endif
 
   TERN_(TOUCH_SCREEN, touch.clear());
+  // Widgets are redrawn on every pass, only those that changed reach the screen
+  TERN_(RS_STYLE_COLOR_UI, tft.queue.track_damage(true));
 
   // heaters and fan
   uint16_t i, x, y = 0, sw = (TFT_WIDTH - (ITEMS_COUNT1 * ITEM_WIDTH1 + ITEMS_COUNT2 * ITEM_WIDTH2)) / (ITEMS_COUNT1 + ITEMS_COUNT2 + 1);
@@ -559,6 +561,7 @@ void MarlinUI::draw_status_screen() {
   tft_string.set(status_message);
   tft_string.trim();
   tft.add_text(tft_string.center(TFT_WIDTH), 0, COLOR_STATUS_MESSAGE, tft_string);
+  tft.queue.track_damage(false);
 #else   // #if ENABLED(RS_STYLE_COLOR_UI)
   for (i = 0 ; i < ITEMS_COUNT; i++) {
     x = (TFT_WIDTH / ITEMS_COUNT - 80) / 2  + (TFT_WIDTH * i / ITEMS_COUNT);
@@ -821,6 +824,22 @@ void TFT::draw_edit_screen_buttons() {
 }
 
 #if ENABLED(RS_STYLE_COLOR_UI)
+  #if ENABLED(THUMBNAILS_PREVIEW)
+    // Runs from the TFT queue once the canvases above it are on the screen
+    static void draw_select_thumbnail() {
+      tft.queue.invalidate(5, 75, 230, 220); // Drawn straight to the TFT
+      if (thumbnails.Open(card.filename))
+      {
+        thumbnails.DrawThumbnail(5, 75, 230, 220);
+        thumbnails.Close();
+      }
+      else
+      {
+        thumbnails.DrawDefaultThumbnail(5, 75, 230, 220);
+      }
+    }
+  #endif
+
   void MenuItem_fileconfirm::draw_select_screen(const char * const string/*=nullptr*/) {
 
     #if ENABLED(THUMBNAILS_PREVIEW)
@@ -844,19 +863,7 @@ void TFT::draw_edit_screen_buttons() {
         tft.add_text(tft_string.center(TFT_WIDTH), 0, COLOR_MENU_TEXT, tft_string);
       }
 
-      bool is_thumb = thumbnails.Open(card.filename);
-      // card.openFileRead(card.filename);
-      // card.closefile();
-
-      if (is_thumb)
-      {
-        thumbnails.DrawThumbnail(5, 75, 230, 220);
-        thumbnails.Close();
-      }
-      else
-      {
-        thumbnails.DrawDefaultThumbnail(5, 75, 230, 220);
-      }
+      tft.callback(draw_select_thumbnail);
     #else  // ENABLED(THUMBNAILS_PREVIEW)
       uint16_t line = 1;
       char  str[256];
@@ -1078,7 +1085,6 @@ static void drawCurZSelection() {
   tft.canvas(motionAxisState.zTypePos.x, motionAxisState.zTypePos.y, tft_string.width(), 34);
   tft.set_background(COLOR_BACKGROUND);
   tft.add_text(0, 0, Z_BTN_COLOR, tft_string);
-  tft.queue.sync();
   tft_string.set("Offset");
   tft.canvas(motionAxisState.zTypePos.x, motionAxisState.zTypePos.y + 34, tft_string.width(), 34);
   tft.set_background(COLOR_BACKGROUND);
@@ -33,6 +33,11 @@
   #error "TFT IO only supports SPI, FSMC or LTDC interface"
 #endif
 
+// Ping-pong canvas strips need a DMA transfer that does not wait for completion
+#if ENABLED(TFT_DOUBLE_BUFFER) && !defined(TFT_IO_ASYNC_DMA)
+  #error "TFT_DOUBLE_BUFFER requires a TFT IO driver with asynchronous DMA."
+#endif
+
 #define TFT_EXCHANGE_XY _BV32(1)
 #define TFT_INVERT_X    _BV32(2)
 #define TFT_INVERT_Y    _BV32(3)
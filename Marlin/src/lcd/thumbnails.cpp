@@ -22,12 +22,6 @@ Thumbnails::Thumbnails()
 
 bool    Thumbnails::Open(char *fname)
 {
- 	const char	TSTRING[] = "thumbnail begin ";
-	const uint32_t	tstrlen = sizeof(TSTRING)-1;
-
-    int32_t		linereaded = 0;
-    char		*tpos;
-
     if (!card.isFileOpen())
     {
         card.closefile();
@@ -35,6 +29,7 @@ bool    Thumbnails::Open(char *fname)
 	
     memset(&decode_info, 0, sizeof(decode_info));
 	decode_info.old_draw_y = -1;
+    is_thumb = false;
 
     card.openFileRead(fname, 9);
     if (!card.isFileOpen())
@@ -42,6 +37,30 @@ bool    Thumbnails::Open(char *fname)
         return FALSE;
     }
 
+    #if ENABLED(THUMBNAILS_CACHE)
+        // готовое изображение в кэше - заголовок G-кода можно не разбирать
+        if (CacheOpen(fname))
+        {
+            is_thumb = true;
+            return TRUE;
+        }
+    #endif
+
+    is_thumb = FindThumbnail();
+    return is_thumb;
+}
+
+
+
+
+bool    Thumbnails::FindThumbnail()
+{
+ 	const char	TSTRING[] = "thumbnail begin ";
+	const uint32_t	tstrlen = sizeof(TSTRING)-1;
+
+    int32_t		linereaded = 0;
+    char		*tpos;
+
 	// ищем признаки встроенного предпросмотра
 	for (uint32_t i = 0; i < 256; i++)
 	{
@@ -71,6 +90,7 @@ bool    Thumbnails::Open(char *fname)
 
 	// запоминаем позицию начала кодированного PNG в файле
 	decode_info.srcfile_begin_pos = card.getIndex();
+	base64.reset();
 
     return TRUE;
 }
@@ -80,13 +100,20 @@ bool    Thumbnails::Open(char *fname)
 
 void    Thumbnails::Close()
 {
-    if (decode_info.img_base64_size == 0)
+    if (!is_thumb)
         return;
 
     DEBUG("Thumbnails: closing");
 
-    png.close();
+    #if ENABLED(THUMBNAILS_CACHE)
+        cache_file.close();
+        cache_valid = false;
+    #endif
+
+    if (decode_info.img_base64_size != 0)
+        png.close();
     card.closefile();
+    is_thumb = false;
 }
 
 
@@ -94,36 +121,262 @@ void    Thumbnails::Close()
 
 void    Thumbnails::DrawThumbnail(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
 {
+    #if ENABLED(THUMBNAILS_CACHE)
+        if (cache_valid)
+        {
+            if (CacheDraw(x, y, w, h))
+                return;
+            // кэш построен для другого размера окна или не прочитан, декодируем заново
+            if (!FindThumbnail())
+            {
+                is_thumb = false;
+                return;
+            }
+        }
+    #endif
+
     if (decode_info.img_base64_size == 0)
         return;
     
-	// вычисляем масштабирование
-	float s1 = (float)decode_info.img_width / (float)w;
-	float s2 = (float)decode_info.img_height / (float)h;
+    CalcScale(x, y, w, h);
+
+    int rc = png.open("", PNGOpen, PNGClose, PNGRead, PNGSeek, PNGDraw);
+    if (rc != PNG_SUCCESS)
+    {
+        return;
+    }
+
+    tft.set_window(x, y, x+decode_info.draw_width-1, y+decode_info.draw_height-1);
+//    tft.set_window(x, y, x+w, y+h);
+    TERN_(THUMBNAILS_CACHE, CacheCreate(w, h));
+    rc = png.decode(NULL, 0);
+    TERN_(THUMBNAILS_CACHE, CacheFinish(rc == PNG_SUCCESS));
+}
+
+
+
+
+// Масштаб в формате 16.16 и карта соответствия столбцов, без плавающей точки - на F1 нет FPU
+void    Thumbnails::CalcScale(uint16_t &x, uint16_t &y, uint16_t w, uint16_t h)
+{
+	// вычисляем масштабирование, округляя вверх, чтобы изображение гарантированно влезло в окно
+	uint32_t s1 = ((decode_info.img_width << 16) + w - 1) / w;
+	uint32_t s2 = ((decode_info.img_height << 16) + h - 1) / h;
 	if (s1 > s2)
 		decode_info.scale = s1;
 	else
 		decode_info.scale = s2;
 
     // пересчитываем координаты верхнего левого угла с учетов масштабирования
-    decode_info.draw_width = decode_info.img_width / decode_info.scale;
-    decode_info.draw_height = decode_info.img_height / decode_info.scale;
+    decode_info.draw_width = (decode_info.img_width << 16) / decode_info.scale;
+    decode_info.draw_height = (decode_info.img_height << 16) / decode_info.scale;
+    NOMORE(decode_info.draw_width, THUMB_MAX_WIDTH);
     if (decode_info.draw_width < w)
         x += (w - decode_info.draw_width) / 2;
     if (decode_info.draw_height < h)
         y += (h - decode_info.draw_height) / 2;
 
-    int rc = png.open("", PNGOpen, PNGClose, PNGRead, PNGSeek, PNGDraw);
-    if (rc != PNG_SUCCESS)
+    // для каждого выходного столбца - первый попадающий в него столбец исходника
+    for (uint32_t dx = 0; dx < decode_info.draw_width; dx++)
+    {
+        uint32_t sx = (dx * decode_info.scale + 0xFFFF) >> 16;
+        NOMORE(sx, decode_info.img_width - 1);
+        colmap[dx] = sx;
+    }
+
+    decode_info.old_draw_y = -1;
+    decode_info.next_src_y = 0;
+}
+
+
+
+
+#if ENABLED(THUMBNAILS_CACHE)
+
+// Ищет в кэше изображение для открытого файла, ключ - имя, размер, дата и первый кластер
+bool    Thumbnails::CacheOpen(const char *fname)
+{
+    dir_t               dir;
+    THUMB_CACHE_HEADER  hdr;
+    SdFile              cache_dir;
+    SdFile              root = card.getroot();
+
+    cache_valid = false;
+    cache_write = false;
+    cache_name[0] = 0;
+    if (!card.getFileDirEntry(&dir))
+        return FALSE;
+
+    memset(&cache_header, 0, sizeof(cache_header));
+    cache_header.file_size = card.getFileSize();
+    cache_header.file_cluster = (uint32_t)dir.firstClusterHigh << 16 | dir.firstClusterLow;
+    cache_header.file_date = dir.lastWriteDate;
+    cache_header.file_time = dir.lastWriteTime;
+
+    // имя файла кэша - FNV-1a хэш от имени и атрибутов файла
+    uint32_t hash = 2166136261UL;
+    for (const char *c = fname; *c; c++)
+        hash = (hash ^ (uint8_t)*c) * 16777619UL;
+    const uint32_t key[3] = { cache_header.file_size, cache_header.file_cluster, (uint32_t)cache_header.file_date << 16 | cache_header.file_time };
+    for (uint8_t i = 0; i < sizeof(key); i++)
+        hash = (hash ^ ((uint8_t*)key)[i]) * 16777619UL;
+    sprintf(cache_name, "%08lX.THB", (unsigned long)hash);
+
+    if (!cache_dir.open(&root, THUMB_CACHE_DIR, O_READ))
+        return FALSE;
+    bool opened = cache_file.open(&cache_dir, cache_name, O_READ);
+    cache_dir.close();
+    if (!opened)
+        return FALSE;
+
+    if (cache_file.read(&hdr, sizeof(hdr)) == sizeof(hdr)
+        && hdr.magic == THUMB_CACHE_MAGIC
+        && hdr.file_size == cache_header.file_size
+        && hdr.file_cluster == cache_header.file_cluster
+        && hdr.file_date == cache_header.file_date
+        && hdr.file_time == cache_header.file_time
+       )
+    {
+        cache_header = hdr;
+        cache_valid = true;
+        return TRUE;
+    }
+
+    cache_file.close();
+    return FALSE;
+}
+
+
+
+
+// Выводит изображение из кэша, по одной DMA передаче на строку
+bool    Thumbnails::CacheDraw(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+{
+    const uint16_t  linesize = cache_header.draw_width * sizeof(uint16_t);
+
+    if (cache_header.box_width != w || cache_header.box_height != h || cache_header.draw_width > THUMB_MAX_WIDTH * 2)
+    {
+        cache_file.close();
+        cache_valid = false;
+        return FALSE;
+    }
+
+    if (cache_header.draw_width < w)
+        x += (w - cache_header.draw_width) / 2;
+    if (cache_header.draw_height < h)
+        y += (h - cache_header.draw_height) / 2;
+
+    tft.set_window(x, y, x+cache_header.draw_width-1, y+cache_header.draw_height-1);
+    for (uint16_t line = 0; line < cache_header.draw_height; line++)
+    {
+        if (cache_file.read(linebuff, linesize) != linesize)
+        {
+            // файл кэша поврежден или обрезан - удалить, изображение будет декодировано заново
+            cache_file.close();
+            cache_valid = false;
+            CacheRemove();
+            return FALSE;
+        }
+        tft.write_sequence(linebuff, cache_header.draw_width);
+    }
+    return TRUE;
+}
+
+
+
+
+// Удаляет файл кэша текущего изображения
+void    Thumbnails::CacheRemove()
+{
+    SdFile      cache_dir;
+    SdFile      root = card.getroot();
+
+    if (cache_name[0] == 0 || card.isWriteLocked())
+        return;
+    if (!cache_dir.open(&root, THUMB_CACHE_DIR, O_READ))
+        return;
+    SdBaseFile::remove(&cache_dir, cache_name);
+    cache_dir.close();
+}
+
+
+
+
+// Создает файл кэша, строки дописываются из PNGDraw по мере декодирования
+void    Thumbnails::CacheCreate(uint16_t w, uint16_t h)
+{
+    SdFile      cache_dir;
+    SdFile      root = card.getroot();
+
+    cache_write = false;
+    cache_lines = 0;
+    if (cache_name[0] == 0 || card.isWriteLocked())
+        return;
+
+    if (!cache_dir.open(&root, THUMB_CACHE_DIR, O_READ) && !cache_dir.mkdir(&root, THUMB_CACHE_DIR))
+        return;
+    bool opened = cache_file.open(&cache_dir, cache_name, O_CREAT | O_WRITE | O_TRUNC);
+    cache_dir.close();
+    if (!opened)
+        return;
+
+    // заголовок станет действительным только после записи всех строк
+    cache_header.magic = 0;
+    cache_header.box_width = w;
+    cache_header.box_height = h;
+    cache_header.draw_width = decode_info.draw_width;
+    cache_header.draw_height = decode_info.draw_height;
+    if (cache_file.write(&cache_header, sizeof(cache_header)) != sizeof(cache_header))
     {
+        cache_file.close();
         return;
     }
+    cache_write = true;
+}
 
-    tft.set_window(x, y, x+decode_info.draw_width-1, y+decode_info.draw_height-1);
-//    tft.set_window(x, y, x+w, y+h);
-    rc = png.decode(NULL, 0);
+
+
+
+void    Thumbnails::CacheLine(uint16_t *line)
+{
+    if (!cache_write)
+        return;
+
+    const int16_t   linesize = cache_header.draw_width * sizeof(uint16_t);
+    if (cache_file.write(line, linesize) != linesize)
+        cache_write = false;
+    else
+        cache_lines++;
+}
+
+
+
+
+void    Thumbnails::CacheFinish(bool ok)
+{
+    if (!cache_write)
+    {
+        cache_file.close();
+        return;
+    }
+    cache_write = false;
+
+    if (ok && cache_lines > 0)
+    {
+        cache_header.magic = THUMB_CACHE_MAGIC;
+        cache_header.draw_height = cache_lines;
+        cache_file.seekSet(0);
+        cache_file.write(&cache_header, sizeof(cache_header));
+        cache_file.close();
+    }
+    else
+    {
+        cache_file.remove();
+    }
 }
 
+#endif  // ENABLED(THUMBNAILS_CACHE)
+
 
 
 
@@ -138,22 +391,7 @@ void    Thumbnails::DrawDefaultThumbnail(uint16_t x, uint16_t y, uint16_t w, uin
     decode_info.img_width = png.getWidth();
     decode_info.img_height = png.getHeight();
 
-	// вычисляем масштабирование
-	float s1 = (float)decode_info.img_width / (float)w;
-	float s2 = (float)decode_info.img_height / (float)h;
-	if (s1 > s2)
-		decode_info.scale = s1;
-	else
-		decode_info.scale = s2;
-
-    // пересчитываем координаты верхнего левого угла с учетов масштабирования
-    decode_info.draw_width = decode_info.img_width / decode_info.scale;
-    decode_info.draw_height = decode_info.img_height / decode_info.scale;
-    if (decode_info.draw_width < w)
-        x += (w - decode_info.draw_width) / 2;
-    if (decode_info.draw_height < h)
-        y += (h - decode_info.draw_height) / 2;
-
+    CalcScale(x, y, w, h);
 
     tft.set_window(x, y, x+decode_info.draw_width-1, y+decode_info.draw_height-1);
 //    tft.set_window(x, y, x+w, y+h);
@@ -190,25 +428,15 @@ int32_t    Thumbnails::ReadLine(uint8_t* buff, uint32_t buffsize)
 
 
 
-void    Thumbnails::base64_decode_block(uint8_t *in, uint8_t *out )
-{   
-    out[0] = (uint8_t) (in[0] << 2 | in[1] >> 4);
-    out[1] = (uint8_t) (in[1] << 4 | in[2] >> 2);
-    out[2] = (uint8_t) (((in[2] << 6) & 0xc0) | in[3]);
-}
-
-
-
-
 uint32_t    Thumbnails::base64_read(uint8_t* buff,	uint32_t size)
 {
-	static const char cd64[] = "|$$$}rstuvwxyz{$$$$$$$>?@ABCDEFGHIJKLMNOPQRSTUVW$$$$$$XYZ[\\]^_`abcdefghijklmnopq";
 	uint32_t	count = 0;
 	int16_t		rd;
+	size_t		used, decoded;
 
 	while (count < size)
 	{
-		// переносим декодированные данные в буфер JPEG
+		// переносим остаток декодированных данных в буфер PNG
 		while (decode_info.buff_current_decpos < decode_info.buff_ready_decbytes)
 		{
 			if (buff)
@@ -223,87 +451,30 @@ uint32_t    Thumbnails::base64_read(uint8_t* buff,	uint32_t size)
 		if (count >= size)
 			break;
 
-		// читаем и декодируем из base64 очередную порцию
-		decode_info.buff_current_decpos = 0;
-		decode_info.buff_ready_decbytes = 0;
-		// считываем сырые данные
-        rd = card.read(strbuff + decode_info.remain_rawbytes, 240);
-		if (rd <= 0)
-			return 0;
-        
-		decode_info.buff_readed_rawbytes = decode_info.remain_rawbytes + rd;
-
-		// чистим считанное от лишних символов (переводы строки, пробелы и т.п.)
-		uint32_t src_pos = 0, dst_pos = 0;
-		while (src_pos < decode_info.buff_readed_rawbytes)
-		{
-			if ((strbuff[src_pos] > 47 && strbuff[src_pos] < 58)			// 0-9
-				|| (strbuff[src_pos] > 64 && strbuff[src_pos] < 91)			// A-Z
-				|| (strbuff[src_pos] > 96 && strbuff[src_pos] < 123)		// a-z
-				|| strbuff[src_pos] == 43									// +
-				|| strbuff[src_pos] == 47									// /
-				)
-			{
-				strbuff[dst_pos++] = strbuff[src_pos++];
-			}
-			else
-			{
-				src_pos++;
-			}
-				
-		}
-		decode_info.buff_readed_rawbytes = dst_pos;
-		dst_pos = 0;
-		src_pos = 0;
-		if (decode_info.buff_readed_rawbytes > 3)
+		// считываем сырые данные блоками по границе сектора, чтобы SdFat читал прямо в буфер
+		if (decode_info.raw_pos >= decode_info.raw_len)
 		{
-			rd = decode_info.buff_readed_rawbytes >> 2;
-			rd <<= 2;
-			decode_info.remain_rawbytes = decode_info.buff_readed_rawbytes % 4;
-		}
-		else
-		{
-			rd = decode_info.buff_readed_rawbytes;
-			decode_info.remain_rawbytes = 0;
+			rd = THUMB_READ_SIZE - (card.getIndex() % THUMB_READ_SIZE);
+			rd = card.read(strbuff, rd);
+			if (rd <= 0)
+				return 0;
+			decode_info.raw_len = rd;
+			decode_info.raw_pos = 0;
 		}
 
-		// декодируем из base64
-		uint8_t		len = 0, i = 0, v = 0;
-		uint8_t		in[4];
-		uint8_t		out[3];
-		while(src_pos < (uint32_t)rd)
+		// декодируем сразу в буфер PNG, если в нем есть место хотя бы под одну группу
+		if (buff && size - count >= 3)
 		{
-			for(len = 0, i = 0; i < 4 && src_pos < (uint32_t)rd; i++)
-			{
-				v = 0;
-				v = strbuff[src_pos++];
-				decode_info.buff_readed_rawbytes--;
-				v = cd64[ v - 43 ];
-				if( v != 0 )
-				{
-					v = ((v == '$') ? 0 : v - 61);
-				}
-				len++;
-				if( v != 0 )
-				{
-					in[i] = v - 1;
-				}
-			}
-			if(len > 0)
-			{
-				base64_decode_block( in, out );
-				for( i = 0; i < len - 1; i++ )
-				{
-					binbuff[dst_pos] = out[i];
-					dst_pos++;
-				}
-				decode_info.buff_ready_decbytes += len - 1;
-			}
+			decoded = base64.decode(strbuff + decode_info.raw_pos, decode_info.raw_len - decode_info.raw_pos, buff + count, size - count, &used);
+			count += decoded;
+			decode_info.imgfile_pos += decoded;
 		}
-		if (decode_info.remain_rawbytes > 0)
+		else
 		{
-			memcpy(strbuff, strbuff+src_pos, decode_info.remain_rawbytes);
+			decode_info.buff_current_decpos = 0;
+			decode_info.buff_ready_decbytes = base64.decode(strbuff + decode_info.raw_pos, decode_info.raw_len - decode_info.raw_pos, binbuff, sizeof(binbuff), &used);
 		}
+		decode_info.raw_pos += used;
 	}
 
 	return count;
@@ -355,9 +526,10 @@ int32_t    Thumbnails::PNGSeek(PNGFILE *handle, int32_t position)
 		length = position;
 		thumbnails.decode_info.buff_current_decpos = 0;
 		thumbnails.decode_info.buff_ready_decbytes = 0;
-		thumbnails.decode_info.buff_readed_rawbytes = 0;
+		thumbnails.decode_info.raw_len = 0;
+		thumbnails.decode_info.raw_pos = 0;
 		thumbnails.decode_info.imgfile_pos = 0;
-		thumbnails.decode_info.remain_rawbytes = 0;
+		thumbnails.base64.reset();
 	}
 
 	
@@ -374,31 +546,28 @@ void    Thumbnails::PNGDraw(PNGDRAW *pDraw)
 {
     // DEBUG("Thumbnails: draw: y=%ld, w=%ld", pDraw->y, pDraw->iWidth);
 
+    DECODE_INFO &di = thumbnails.decode_info;
     uint16_t    *spixline = thumbnails.linebuff;
     uint16_t    *dpixline = thumbnails.linebuff + THUMB_MAX_WIDTH;
-	int32_t	    curr_x = -1, new_x = 0, curr_y = 0, src_x = 0;
 
-	curr_y = (uint32_t)((float)pDraw->y / thumbnails.decode_info.scale);
-    if (curr_y == thumbnails.decode_info.old_draw_y)
+    // строка не попадает ни в одну выходную - даже не конвертируем
+    if ((uint32_t)pDraw->y < di.next_src_y || di.old_draw_y + 1 >= (int32_t)di.draw_height)
         return;
-    
+
     // конвертируем пиксели в 16 бит
     thumbnails.png.getLineAsRGB565(pDraw, spixline, PNG_RGB565_LITTLE_ENDIAN, 0xFFFFFFFF);
 
-	while (thumbnails.decode_info.old_draw_y < curr_y)
+    for (uint32_t dx = 0; dx < di.draw_width; dx++)
+        dpixline[dx] = spixline[thumbnails.colmap[dx]];
+
+    // при увеличении одна исходная строка может дать несколько выходных
+	while (di.next_src_y <= (uint32_t)pDraw->y && di.old_draw_y + 1 < (int32_t)di.draw_height)
 	{
-		while (src_x < pDraw->iWidth)
-		{
-			new_x = (uint32_t)((float)src_x / thumbnails.decode_info.scale);
-			while (new_x > curr_x)
-			{
-				curr_x++;
-				dpixline[curr_x] = spixline[src_x];
-			}
-			src_x++;
-		}
-		thumbnails.decode_info.old_draw_y++;
-        tft.write_sequence(dpixline, thumbnails.decode_info.draw_width);
+		di.old_draw_y++;
+        tft.write_sequence(dpixline, di.draw_width);
+        TERN_(THUMBNAILS_CACHE, thumbnails.CacheLine(dpixline));
+        di.next_src_y = ((uint32_t)(di.old_draw_y + 1) * di.scale + 0xFFFF) >> 16;
+        NOMORE(di.next_src_y, di.img_height - 1);
 	}
 
 }
@@ -8,9 +8,11 @@
 #include "../sd/cardreader.h"
 
 #include "../module/PNGdec/PNGdec.h"
+#include "../libs/base64.h"
 
 #define		THUMB_MAX_WIDTH		640
 #define		THUMB_MIN_WIDTH		100
+#define		THUMB_READ_SIZE		512		// размер порции base64 при чтении с SD
 
 typedef struct
 {
@@ -20,15 +22,37 @@ typedef struct
 	uint32_t	srcfile_begin_pos;
 	uint32_t	buff_ready_decbytes;
 	uint32_t	buff_current_decpos;
-	uint32_t	buff_readed_rawbytes;
+	uint32_t	raw_len;
+	uint32_t	raw_pos;
 	uint32_t	imgfile_pos;
-	uint32_t	remain_rawbytes;
 	uint32_t	draw_width;
 	uint32_t	draw_height;
-	float		scale;
+	uint32_t	scale;				// исходных пикселей на выходной, 16.16
 	int32_t		old_draw_y;
+	uint32_t	next_src_y;			// исходная строка, нужная для следующей выходной
 } DECODE_INFO;
 
+#if ENABLED(THUMBNAILS_CACHE)
+
+#define		THUMB_CACHE_DIR		"THUMBS"
+#define		THUMB_CACHE_MAGIC	0x31424854		// "THB1"
+
+// Заголовок файла кэша, за ним draw_height строк по draw_width пикселей RGB565
+typedef struct
+{
+	uint32_t	magic;
+	uint32_t	file_size;
+	uint32_t	file_cluster;
+	uint16_t	file_date;
+	uint16_t	file_time;
+	uint16_t	box_width;
+	uint16_t	box_height;
+	uint16_t	draw_width;
+	uint16_t	draw_height;
+} THUMB_CACHE_HEADER;
+
+#endif
+
 
 
 class Thumbnails
@@ -38,13 +62,32 @@ class Thumbnails
         DECODE_INFO         decode_info;
         PNG			        png;
         uint16_t     		linebuff[THUMB_MAX_WIDTH*2];
-        uint8_t		        strbuff[256];
+        uint16_t     		colmap[THUMB_MAX_WIDTH];
+        Base64Decoder       base64;
+        uint8_t		        strbuff[THUMB_READ_SIZE] __attribute__((aligned(4)));
         uint8_t		        binbuff[256];
         bool                is_thumb;
 
+        #if ENABLED(THUMBNAILS_CACHE)
+            THUMB_CACHE_HEADER  cache_header;
+            SdFile              cache_file;
+            char                cache_name[13];
+            bool                cache_valid;
+            bool                cache_write;
+            uint16_t            cache_lines;
+
+            bool                CacheOpen(const char *fname);
+            bool                CacheDraw(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+            void                CacheCreate(uint16_t w, uint16_t h);
+            void                CacheLine(uint16_t *line);
+            void                CacheFinish(bool ok);
+            void                CacheRemove();
+        #endif
+
+        bool                FindThumbnail();
+        void                CalcScale(uint16_t &x, uint16_t &y, uint16_t w, uint16_t h);
         int32_t		        ReadLine(uint8_t* buff, uint32_t buffsize);
         uint32_t            base64_read(uint8_t* buff,	uint32_t size);
-        void                base64_decode_block(uint8_t *in, uint8_t *out);
 
         static void*		PNGOpen(const char *filename, int32_t *size);
         static void		    PNGClose(void *handle);
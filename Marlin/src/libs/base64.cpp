@@ -0,0 +1,104 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if EITHER(THUMBNAILS_PREVIEW, MARLIN_DEV_MODE)
+
+#include "base64.h"
+
+// Reverse alphabet: 6-bit value of the character, BASE64_PAD or BASE64_SKIP
+const uint8_t Base64Decoder::table[256] = {
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x3E, 0x80, 0x80, 0x80, 0x3F,
+  0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0x80, 0x80, 0x80, 0x81, 0x80, 0x80,
+  0x80, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+  0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+  0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+  0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+};
+
+size_t Base64Decoder::decode(const uint8_t *src, const size_t len, uint8_t *dst, const size_t room, size_t *used) {
+  const uint8_t *s = src, * const se = src + len;
+  uint8_t *d = dst, * const de = dst + room;
+
+  while (s < se) {
+    // Whole group in one 32-bit load (all supported targets are little-endian)
+    if (!chars && se - s >= 4 && de - d >= 3) {
+      uint32_t w;
+      memcpy(&w, s, sizeof(w));
+      const uint8_t a = table[w & 0xFF], b = table[(w >> 8) & 0xFF],
+                    c = table[(w >> 16) & 0xFF], e = table[w >> 24];
+      if (!((a | b | c | e) & BASE64_SKIP)) {
+        const uint32_t v = (uint32_t(a) << 18) | (uint32_t(b) << 12) | (uint32_t(c) << 6) | e;
+        d[0] = uint8_t(v >> 16);
+        d[1] = uint8_t(v >> 8);
+        d[2] = uint8_t(v);
+        d += 3;
+        s += 4;
+        continue;
+      }
+    }
+
+    // Group broken by a line break or comment - one character at a time
+    const uint8_t v = table[*s];
+    if (v == BASE64_PAD && chars >= 2) {
+      // Padding ends the group: 2 characters hold one byte, 3 hold two
+      if (de - d < chars - 1) break;
+      s++;
+      if (chars == 2)
+        *d++ = uint8_t(acc >> 4);
+      else {
+        d[0] = uint8_t(acc >> 10);
+        d[1] = uint8_t(acc >> 2);
+        d += 2;
+      }
+      reset();
+      continue;
+    }
+    if (v & BASE64_SKIP) { s++; continue; }
+    if (chars == 3 && de - d < 3) break;
+    s++;
+    acc = (acc << 6) | v;
+    if (++chars == 4) {
+      d[0] = uint8_t(acc >> 16);
+      d[1] = uint8_t(acc >> 8);
+      d[2] = uint8_t(acc);
+      d += 3;
+      reset();
+    }
+  }
+
+  if (used) *used = s - src;
+  return d - dst;
+}
+
+#endif // THUMBNAILS_PREVIEW || MARLIN_DEV_MODE
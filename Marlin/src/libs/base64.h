@@ -0,0 +1,56 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2020 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * Streaming base64 decoder
+ *
+ * Characters outside the base64 alphabet (line breaks, G-code comment
+ * prefixes) are skipped, so the text of an embedded thumbnail can be fed
+ * in as it is read from the file. An incomplete group of four characters
+ * is kept between calls. '=' padding ends a short group and emits its
+ * one or two bytes.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BASE64_SKIP 0x80
+#define BASE64_PAD  0x81  // '=' (also fails the BASE64_SKIP test)
+
+class Base64Decoder {
+  public:
+    static const uint8_t table[256];
+
+    void reset() { acc = 0; chars = 0; }
+
+    /**
+     * Decode up to 'len' characters from 'src' into 'dst' (at most 'room' bytes).
+     * Stops early when the next group would not fit into 'dst'.
+     * Returns the number of bytes written, '*used' receives the number of characters consumed.
+     */
+    size_t decode(const uint8_t *src, const size_t len, uint8_t *dst, const size_t room, size_t *used);
+
+  private:
+    uint32_t acc = 0;
+    uint8_t chars = 0;
+};
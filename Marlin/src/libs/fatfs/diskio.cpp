@@ -11,8 +11,63 @@
 #include "diskio.h"		/* FatFs lower layer API */
 #ifdef MKS_WIFI
 
+#include "../../sd/cardreader.h"
+#include "fatfs_shared.h"
+
 volatile uint8_t __attribute__ ((aligned (4))) buf_copy[512];
 
+/*
+Если карта смонтирована Марлином (идет печать), FatFs не инициализирует
+карту заново, а читает и пишет секторы через драйвер Марлина.
+*/
+static uint8_t card_shared = 0;
+
+#if HAS_SD_BLOCK_CACHE
+/*
+Марлин записал сектор через общий кэш - окно FatFs с этим сектором
+устарело. Грязное окно не трогаем, его сейчас записывает сама FatFs.
+*/
+static void disk_block_written(const uint32_t block){
+	if((FATFS_Obj.winsect == (LBA_t)block) && !FATFS_Obj.wflag) FATFS_Obj.winsect = (LBA_t)-1;
+}
+#endif
+
+void disk_share_card(uint8_t shared){
+	card_shared = shared;
+	#if HAS_SD_BLOCK_CACHE
+	if(shared) card.media_cache.addWriteHook(disk_block_written);
+	else card.media_cache.removeWriteHook(disk_block_written);
+	#endif
+}
+
+uint8_t disk_card_shared(void){
+	return card_shared;
+}
+
+static DRESULT disk_transfer_shared(BYTE *buff, DWORD sector, UINT count, uint8_t write){
+	DiskIODriver *driver = card.diskIODriver();
+	bool ok;
+
+	while (count--){
+		if(((uint32_t)buff % 4) != 0){
+			if(write){
+				memcpy((uint8_t *)buf_copy,(uint8_t *)buff,512);
+				ok = driver->writeBlock(sector, (uint8_t *)buf_copy);
+			}else{
+				ok = driver->readBlock(sector, (uint8_t *)buf_copy);
+				if(ok) memcpy((uint8_t *)buff,(uint8_t *)buf_copy,512);
+			}
+		}else{
+			ok = write ? driver->writeBlock(sector, buff) : driver->readBlock(sector, buff);
+		}
+
+		if(!ok) return RES_ERROR;
+		buff+=512;
+		sector++;
+	}
+	return RES_OK;
+}
+
 /* Definitions of physical drive number for each drive */
 #define DEV_SD		0	/* Example: Map MMC/SD card to physical drive 1 */
 
@@ -44,6 +99,7 @@ DSTATUS disk_initialize (
 	int result;
 		
 	if(pdrv == DEV_SD){
+		if(card_shared) return(0); //Карта уже инициализирована Марлином
 		result=SD_Init();
 		if(result != 0) {
 			return STA_NOINIT;
@@ -69,6 +125,8 @@ DRESULT disk_read (
 uint8_t res=0;
 	
 	if(pdrv == DEV_SD){
+
+		if(card_shared) return disk_transfer_shared(buff, sector, count, 0);
 	
 		if(((uint32_t)buff % 4) != 0){
 			DEBUG("Buffer not aligned");
@@ -118,6 +176,8 @@ uint8_t res;
 
 	if(pdrv == DEV_SD){
 
+		if(card_shared) return disk_transfer_shared((BYTE *)buff, sector, count, 1);
+
 		if(((uint32_t)buff % 4) != 0){
 			DEBUG("Buffer not aligned");
 			while (count--){
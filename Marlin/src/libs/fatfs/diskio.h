@@ -49,6 +49,9 @@ DRESULT disk_read (BYTE pdrv, BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_write (BYTE pdrv, const BYTE* buff, DWORD sector, UINT count);
 DRESULT disk_ioctl (BYTE pdrv, BYTE cmd, void* buff);
 
+void disk_share_card(uint8_t shared);
+uint8_t disk_card_shared(void);
+
 
 /* Disk Status Bits (DSTATUS) */
 
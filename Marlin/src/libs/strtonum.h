@@ -0,0 +1,114 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * strtonum.h - Fast conversion of G-code numbers
+ *
+ * G-code numbers are plain decimals: an optional sign, digits and an optional
+ * fraction. No exponent (a following 'E' is the extruder axis), no hex, no
+ * inf/nan. So a number can be read in one pass of integer math followed by a
+ * single float multiply or divide, instead of the general-purpose libc
+ * strtof/strtol, which are slow soft-float code on parts without an FPU.
+ *
+ * Numbers with up to 7 significant digits (all slicer output) convert to the
+ * correctly rounded float, exactly as strtof does. Longer ones keep the first
+ * 9 digits and are off by at most one ulp.
+ *
+ * Only <stdint.h> is needed, so host-side tools can include this too.
+ */
+
+#include <stdint.h>
+
+#define STRTONUM_MAX_DIGITS 9   // Significant digits that fit in a uint32_t
+#define STRTONUM_MAX_EXP   10   // 10^10 is the largest power of ten that's exact as a float
+
+// Skip leading spaces and a sign
+inline const char* strtonum_sign(const char *s, bool &neg) {
+  while (*s == ' ') s++;
+  neg = (*s == '-');
+  if (neg || *s == '+') s++;
+  return s;
+}
+
+// Digits to uint32_t. Sets 'over' and stops accumulating past UINT32_MAX.
+inline uint32_t strtonum_digits(const char *s, bool &over) {
+  uint32_t v = 0;
+  over = false;
+  for (uint8_t d; (d = uint8_t(*s - '0')) <= 9; s++) {
+    if (v >= UINT32_MAX / 10 && (v > UINT32_MAX / 10 || d > UINT32_MAX % 10)) over = true;
+    if (!over) v = v * 10 + d;
+  }
+  return v;
+}
+
+// Decimal to uint32_t like strtoul(s, nullptr, 10). A '-' negates the result.
+// Saturates at UINT32_MAX on overflow, as strtoul does.
+inline uint32_t gcode_strtoul(const char *s) {
+  bool neg, over;
+  const uint32_t v = strtonum_digits(strtonum_sign(s, neg), over);
+  return over ? UINT32_MAX : neg ? 0 - v : v;
+}
+
+// Decimal to int32_t like strtol(s, nullptr, 10). Saturates at INT32_MIN / INT32_MAX.
+inline int32_t gcode_strtol(const char *s) {
+  bool neg, over;
+  const uint32_t v = strtonum_digits(strtonum_sign(s, neg), over);
+  if (neg) return (over || v >= uint32_t(INT32_MAX) + 1) ? INT32_MIN : -int32_t(v);
+  return (over || v > uint32_t(INT32_MAX)) ? INT32_MAX : int32_t(v);
+}
+
+// Decimal to float like strtof, stopping at an 'E'
+inline float gcode_strtof(const char *s) {
+  static constexpr float powers[STRTONUM_MAX_EXP + 1] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+
+  bool neg;
+  s = strtonum_sign(s, neg);
+
+  uint32_t m = 0;       // Significant digits
+  uint8_t digits = 0;   // Count of significant digits in m
+  int8_t e10 = 0;       // Decimal exponent to apply to m
+  uint8_t d;
+
+  // Integer part. Digits past the precision only scale the result.
+  for (; (d = uint8_t(*s - '0')) <= 9; s++) {
+    if (digits < STRTONUM_MAX_DIGITS) {
+      m = m * 10 + d;
+      if (m) digits++;
+    }
+    else if (e10 < STRTONUM_MAX_EXP)
+      e10++;
+  }
+
+  // Fraction. Digits past the precision are dropped.
+  if (*s == '.')
+    for (s++; (d = uint8_t(*s - '0')) <= 9; s++) {
+      if (digits >= STRTONUM_MAX_DIGITS || e10 <= -STRTONUM_MAX_EXP) continue;
+      m = m * 10 + d;
+      if (m) digits++;
+      e10--;
+    }
+
+  // The mantissa and the power of ten are exact, so one rounding for short numbers
+  const float f = e10 < 0 ? float(m) / powers[-e10] : float(m) * powers[e10];
+  return neg ? -f : f;
+}
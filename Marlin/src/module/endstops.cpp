@@ -63,6 +63,9 @@ bool Endstops::enabled, Endstops::enabled_globally; // Initialized by settings.l
 
 volatile Endstops::endstop_mask_t Endstops::hit_state;
 Endstops::endstop_mask_t Endstops::live_state = 0;
+#if ENABLED(RS_ADDSETTINGS)
+  Endstops::endstop_mask_t Endstops::inverting_bits; // Initialized by settings.load()
+#endif
 
 #if ENDSTOP_NOISE_THRESHOLD
   Endstops::endstop_mask_t Endstops::validated_live_state;
@@ -101,6 +104,31 @@ Endstops::endstop_mask_t Endstops::live_state = 0;
  * Class and Instance Methods
  */
 
+#if ENABLED(RS_ADDSETTINGS)
+
+  /**
+   * Fold endstop_settings into one mask, so update() tests bits of a single
+   * value instead of loading a setting for every endstop it reads.
+   */
+  void Endstops::refresh_inverting() {
+    endstop_mask_t bits = 0;
+    #define _INV_BIT(S, V) do{ if (V) SBI(bits, S); }while(0)
+    TERN_(HAS_X_MIN,  _INV_BIT(X_MIN,  endstop_settings.X_MIN_INVERTING));
+    TERN_(HAS_X_MAX,  _INV_BIT(X_MAX,  endstop_settings.X_MAX_INVERTING));
+    TERN_(HAS_Y_MIN,  _INV_BIT(Y_MIN,  endstop_settings.Y_MIN_INVERTING));
+    TERN_(HAS_Y_MAX,  _INV_BIT(Y_MAX,  endstop_settings.Y_MAX_INVERTING));
+    TERN_(HAS_Z_MIN,  _INV_BIT(Z_MIN,  endstop_settings.Z_MIN_INVERTING));
+    TERN_(HAS_Z_MAX,  _INV_BIT(Z_MAX,  endstop_settings.Z_MAX_INVERTING));
+    TERN_(HAS_Z2_MIN, _INV_BIT(Z2_MIN, endstop_settings.Z2_MIN_INVERTING));
+    TERN_(HAS_Z2_MAX, _INV_BIT(Z2_MAX, endstop_settings.Z2_MAX_INVERTING));
+    // The probe has no runtime setting
+    TERN_(USES_Z_MIN_PROBE_PIN, _INV_BIT(Z_MIN_PROBE, Z_MIN_PROBE_ENDSTOP_INVERTING));
+    #undef _INV_BIT
+    inverting_bits = bits;
+  }
+
+#endif
+
 void Endstops::init() {
 
   #if HAS_X_MIN
@@ -612,7 +640,7 @@ void _O2 Endstops::report_states() {
   #define __ENDSTOP(AXIS, MINMAX) AXIS ##_## MINMAX
   #define _ENDSTOP_PIN(AXIS, MINMAX) AXIS ##_## MINMAX ##_PIN
   #if ENABLED(RS_ADDSETTINGS)
-    #define _ENDSTOP_INVERTING(AXIS, MINMAX) endstop_settings.AXIS ##_## MINMAX ##_INVERTING
+    #define _ENDSTOP_INVERTING(AXIS, MINMAX) TEST(inverting, __ENDSTOP(AXIS, MINMAX))
   #else
     #define _ENDSTOP_INVERTING(AXIS, MINMAX) AXIS ##_## MINMAX ##_ENDSTOP_INVERTING
   #endif  // ENABLED(RS_ADDSETTINGS)
@@ -626,6 +654,10 @@ void Endstops::update() {
     if (!abort_enabled()) return;
   #endif
 
+  #if ENABLED(RS_ADDSETTINGS) && !HAS_DELTA_SENSORLESS_PROBING
+    const endstop_mask_t inverting = inverting_bits;
+  #endif
+
   #define UPDATE_ENDSTOP_BIT(AXIS, MINMAX) SET_BIT_TO(live_state, _ENDSTOP(AXIS, MINMAX), (READ(_ENDSTOP_PIN(AXIS, MINMAX)) != _ENDSTOP_INVERTING(AXIS, MINMAX)))
   #define COPY_LIVE_STATE(SRC_BIT, DST_BIT) SET_BIT_TO(live_state, DST_BIT, TEST(live_state, SRC_BIT))
 
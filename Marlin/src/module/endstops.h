@@ -158,6 +158,9 @@ class Endstops {
   private:
     static bool enabled, enabled_globally;
     static endstop_mask_t live_state;
+    #if ENABLED(RS_ADDSETTINGS)
+      static endstop_mask_t inverting_bits; // Endstops read inverted, from endstop_settings
+    #endif
     static volatile endstop_mask_t hit_state; // Use X_MIN, Y_MIN, Z_MIN and Z_MIN_PROBE as BIT index
 
     #if ENDSTOP_NOISE_THRESHOLD
@@ -173,6 +176,11 @@ class Endstops {
      */
     static void init();
 
+    #if ENABLED(RS_ADDSETTINGS)
+      // Call after changing endstop_settings
+      static void refresh_inverting();
+    #endif
+
     /**
      * Are endstops or the probe set to abort the move?
      */
@@ -69,6 +69,48 @@ void mks_wifi_set_param(void){
 	};
 }
 
+#if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+/*
+Пока UART занят приемом файла, готовые строки копятся здесь
+и отправляются в ESP после загрузки. Что не поместилось - считается.
+*/
+static uint8_t out_deferred[MKS_WIFI_DEFERRED_SIZE];
+static uint16_t out_deferred_len = 0;
+static uint16_t out_deferred_lost = 0;
+
+static void mks_wifi_out_defer(uint8_t *line, uint32_t size){
+	if((out_deferred_len + size + 1) > MKS_WIFI_DEFERRED_SIZE){
+		out_deferred_lost++;
+		return;
+	}
+	memcpy(out_deferred + out_deferred_len, line, size);
+	out_deferred_len += size;
+	out_deferred[out_deferred_len++] = 0x0a;
+}
+
+/*
+Отправляет отложенные строки по одной. send=false - ESP перезагружается, строки отбрасываются
+*/
+void mks_wifi_out_flush(bool send){
+	uint16_t start = 0;
+
+	if(send){
+		for(uint16_t i = 0; i < out_deferred_len; i++){
+			if(out_deferred[i] != 0x0a) continue;
+			mks_wifi_out_add(out_deferred + start, i - start + 1);
+			start = i + 1;
+		}
+		if(out_deferred_lost){
+			char str[48];
+			sprintf(str, "echo:%u lines dropped during upload\n", out_deferred_lost);
+			mks_wifi_out_add((uint8_t *)str, strlen(str));
+		}
+	}
+	out_deferred_len = 0;
+	out_deferred_lost = 0;
+}
+#endif
+
 /*
 Получает данные из всех функций, как только
 есть перевод строки 0x0A, формирует пакет для
@@ -81,6 +123,15 @@ void mks_wifi_out_add(uint8_t *data, uint32_t size){
 
 	while (size--){
 		if(*data == 0x0a){
+			#if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+			//UART занят приемом файла, строка уйдет после загрузки
+			if(mks_wifi_upload_active()){
+				mks_wifi_out_defer(mks_out_buffer, line_index);
+				memset(mks_out_buffer,0,MKS_OUT_BUFF_SIZE);
+				line_index=0;
+				break;
+			}
+			#endif
 			//Перевод строки => сформировать пакет, отправить, сбросить индекс
 			esp_frame.type=ESP_TYPE_FILE_FIRST; //Название типа из прошивки MKS. Смысла не имееет.
 			esp_frame.dataLen=strnlen((char *)mks_out_buffer,MKS_OUT_BUFF_SIZE);
@@ -328,15 +379,23 @@ void mks_wifi_parse_packet(ESP_PROTOC_FRAME *packet){
 			break;
 		case ESP_TYPE_FILE_FIRST:
 				DEBUG("[FILE_FIRST]");
+				#if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+				//Файл принимается в фоне, печать продолжается
+				mks_wifi_start_file_upload(packet);
+				#else
 				//Передача файла останавливает все процессы, 
 				//поэтому печать в этот момент не возможна.
 				if (!CardReader::isPrinting()){
 					mks_wifi_start_file_upload(packet);
 				}
+				#endif
 			break;
 		case ESP_TYPE_FILE_FRAGMENT:
 				DEBUG("[FILE_FRAGMENT]");
 			break;
+		case ESP_TYPE_FILE_FRAGMENT_HS:
+				DEBUG("[FILE_FRAGMENT_HS]");
+			break;
 		case ESP_TYPE_WIFI_LIST:
 			DEBUG("[WIFI_LIST]");
 			break;
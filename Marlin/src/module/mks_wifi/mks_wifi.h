@@ -32,6 +32,9 @@ typedef struct
 #define ESP_TYPE_FILE_FIRST			(uint8_t)0x2
 #define ESP_TYPE_FILE_FRAGMENT		(uint8_t)0x3
 #define ESP_TYPE_WIFI_LIST		    (uint8_t)0x4
+//Фрагмент файла, сжатый heatshrink (окно 2^8, lookahead 2^4),
+//распаковывается при записи на карту
+#define ESP_TYPE_FILE_FRAGMENT_HS	(uint8_t)0x6
 
 #define ESP_PACKET_DATA_MAX_SIZE	1024
 #define ESP_SERIAL_OUT_MAX_SIZE		1024
@@ -66,5 +69,10 @@ uint8_t check_char_allowed(char data);
 
 void mks_wifi_send(uint8_t *packet, uint16_t size);
 
+#if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+#define MKS_WIFI_DEFERRED_SIZE 512   //Строки для ESP, отложенные на время приема файла
+void mks_wifi_out_flush(bool send);
+#endif
+
 #endif
 #endif
\ No newline at end of file
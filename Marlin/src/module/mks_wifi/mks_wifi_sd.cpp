@@ -6,9 +6,14 @@
 #include "../../libs/buzzer.h"  
 #include "../temperature.h"
 #include "../../libs/fatfs/fatfs_shared.h"
+#include "../../libs/fatfs/diskio.h"
 #include "uart.h"
 #include "../../libs/numtostr.h"
 
+#if ENABLED(MKS_WIFI_COMPRESSED_UPLOAD)
+#include "../../libs/heatshrink/heatshrink_decoder.h"
+#endif
+
 #ifdef MKS_WIFI
 
 #if ENABLED(TFT_480x320) || ENABLED(TFT_480x320_SPI)
@@ -42,7 +47,22 @@ void mks_wifi_sd_ls(void){
    f_closedir((DIR*)&dir);
 }
 
+/*
+FatFs и Марлин работают с картой через один драйвер и общий кэш секторов,
+поэтому переключение между загрузкой, M20 и печатью не требует
+перемонтирования. Если Марлин не смог смонтировать карту, FatFs
+инициализирует ее сама, как раньше.
+*/
 uint8_t mks_wifi_sd_init(void){
+   if(!card.isMounted()) card.mount(true);
+
+   if(card.isMounted()){
+      disk_share_card(1);
+      res = f_mount((FATFS *)&FATFS_Obj, "0", 1);
+      if(res == FR_OK) return 0;
+      disk_share_card(0);
+   }
+
    card.release();
    res = f_mount((FATFS *)&FATFS_Obj, "0", 1);
    return (uint8_t)res;
@@ -50,11 +70,23 @@ uint8_t mks_wifi_sd_init(void){
 
 void mks_wifi_sd_deinit(void){
    f_mount(0, "", 1);
+
+   if(disk_card_shared()){
+      disk_share_card(0);
+      //Перечитать корень, чтобы список файлов увидел изменения FatFs
+      TERN_(HAS_SD_DIR_INDEX, card.invalidateDirIndex());
+      if(!card.isFileOpen()) card.cdroot();
+      return;
+   }
+
    delay(500);
    card.mount(true);
 };
 
 void sd_delete_file(char *filename){
+   #if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+   if(mks_wifi_upload_active()) return; //FatFs занят приемом файла
+   #endif
    mks_wifi_sd_init();
    f_unlink(filename);
    mks_wifi_sd_deinit();
@@ -67,6 +99,10 @@ void sd_delete_file(char *filename){
 
 uint8_t get_dos_filename(char *filename, char* dosfilename){
     uint8_t ret_val=0;
+
+   #if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+   if(mks_wifi_upload_active()) return 0; //FatFs занят приемом файла
+   #endif
    
    mks_wifi_sd_init();
 
@@ -95,6 +131,393 @@ uint8_t get_dos_filename(char *filename, char* dosfilename){
 
 
 
+#if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+/*
+Прием файла в фоне. DMA принимает пакеты от ESP в два буфера,
+а запись в файл идет из idle(), поэтому печать и нагрев
+во время загрузки не останавливаются.
+*/
+
+typedef struct {
+   bool     active;
+   uint32_t file_size;
+   uint32_t file_received;   //Данные файла, полученные от ESP (после распаковки)
+   uint32_t file_inc_size;
+   uint32_t file_size_writen;
+   uint16_t last_sector;
+   uint8_t  percent;
+   uint8_t  rd_index;        //Индекс буфера DMA, который обрабатывается следующим
+   millis_t timeout_ms;
+   char     file_name[100];
+} MKS_WIFI_UPLOAD;
+
+static MKS_WIFI_UPLOAD upload;
+static millis_t esp_reset_ms = 0;   //Время, когда отпустить сброс ESP (0 - сброса нет)
+
+#if ENABLED(MKS_WIFI_COMPRESSED_UPLOAD)
+static heatshrink_decoder hsd;
+#endif
+
+bool mks_wifi_upload_active(void){
+   return upload.active;
+}
+
+static void mks_wifi_dma_arm(volatile uint8_t *buffer){
+   #ifdef STM32F1
+   DMA1_Channel5->CCR = DMA_CONF;
+   DMA1_Channel5->CMAR = (uint32_t)buffer;
+   DMA1_Channel5->CNDTR = ESP_PACKET_SIZE;
+   DMA1_Channel5->CCR = DMA_CONF|DMA_CCR_EN;
+   #endif
+
+   #ifdef STM32F4
+   DMA2_Stream5->CR = DMA_CONF;
+   DMA2_Stream5->M0AR = (uint32_t)buffer;
+   DMA2_Stream5->NDTR = ESP_PACKET_SIZE;
+   DMA2_Stream5->CR = DMA_CONF|DMA_SxCR_EN;
+   #endif
+}
+
+static void mks_wifi_rx_start(void){
+   dma_buff_index = 0;
+   buffer_ready = 0;
+   dma_stopped = 0;
+
+   #ifdef STM32F1
+   //Максимальная частота в режиме out
+   GPIOC->CRL |= GPIO_CRL_MODE7;
+   GPIOC->CRL &= ~GPIO_CRL_CNF7;
+
+   DMA1->IFCR = DMA_CLEAR;
+   DMA1_Channel5->CPAR = (uint32_t)&USART1->DR;
+
+   USART1->CR1 = USART_CR1_UE;
+   USART1->CR1 = USART_CR1_TE | USART_CR1_UE;
+   USART1->BRR = 0x25;
+   #endif
+
+   #ifdef STM32F4
+   DMA2_Stream5->CR = 0;
+   DMA2->HIFCR = DMA_S5_CLEAR;
+   DMA2_Stream5->PAR = (uint32_t)&USART1->DR;
+
+   USART1->CR1 = USART_CR1_UE;
+   USART1->CR1 = USART_CR1_TE | USART_CR1_UE;
+   USART1->BRR = (uint32_t)(84000000+1958400/2)/1958400;
+   #endif
+
+   USART1->CR2 = 0;
+   USART1->CR3 = 0;
+   USART1->CR1 |= USART_CR1_RE;
+
+   //Сбросить ORE/RXNE до включения DMA, чтобы не отнять байт у передачи
+   (void)USART1->SR;
+   (void)USART1->DR;
+
+   mks_wifi_dma_arm(dma_buff[dma_buff_index]);
+   #ifdef STM32F1
+   NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+   #endif
+   #ifdef STM32F4
+   NVIC_EnableIRQ(DMA2_Stream5_IRQn);
+   #endif
+   USART1->CR3 = USART_CR3_DMAR;
+}
+
+static void mks_wifi_rx_stop(void){
+   #ifdef STM32F1
+   NVIC_DisableIRQ(DMA1_Channel5_IRQn);
+   DMA1->IFCR = DMA_CLEAR;
+   DMA1_Channel5->CCR = 0;
+   #endif
+
+   #ifdef STM32F4
+   NVIC_DisableIRQ(DMA2_Stream5_IRQn);
+   DMA2->HIFCR = DMA_S5_CLEAR;
+   DMA2_Stream5->CR = 0;
+   #endif
+
+   MYSERIAL2.begin(BAUDRATE_2);
+   WRITE(MKS_WIFI_IO4, LOW); //Включить передачу от ESP
+}
+
+static void mks_wifi_upload_finish(bool esp_reset){
+   UINT bytes_writen=0;
+
+   mks_wifi_rx_stop();
+
+   if(esp_reset){
+      //Restart ESP8266. Сброс отпускается из idle() через 200 мс
+      WRITE(MKS_WIFI_IO_RST, LOW);
+      esp_reset_ms = millis() + 200;
+   }
+
+   if(!esp_reset && file_data_size != 0){
+      upload.file_inc_size += file_data_size;
+      DEBUG("Save last %d bytes from buffer (%d of %d) ",file_data_size,upload.file_inc_size,upload.file_size);
+      res=f_write((FIL *)&upload_file,(uint8_t*)file_buff,file_data_size,&bytes_writen);
+      if(res) ERROR("Write err %d",res);
+      upload.file_size_writen += bytes_writen;
+   }
+
+   #if ENABLED(MKS_WIFI_COMPRESSED_UPLOAD)
+   //Поток heatshrink должен быть распакован до конца, иначе файл обрезан
+   const bool stream_done = (heatshrink_decoder_finish(&hsd) == HSDR_FINISH_DONE);
+   if(!stream_done) ERROR("Heatshrink stream not finished");
+   #else
+   constexpr bool stream_done = true;
+   #endif
+
+   f_close((FIL *)&upload_file);
+   DEBUG("File closed");
+
+   const bool upload_ok = stream_done && (upload.file_size == upload.file_inc_size) && (upload.file_size == upload.file_size_writen);
+
+   if(!upload_ok){
+      DEBUG("Upload failed! File size: %d; Recieve %d; SD write %d",upload.file_size,upload.file_inc_size,upload.file_size_writen);
+      f_rename(upload.file_name,"file_failed.gcode");
+   }
+
+   upload.active = false;
+   //Ответы, накопленные за время загрузки. После сброса ESP их некому принять
+   mks_wifi_out_flush(!esp_reset);
+   mks_wifi_sd_deinit();
+
+   if(upload_ok){
+      ui.set_status((const char *)"Upload done",true);
+      DEBUG("Upload ok");
+      BUZZ(1000,260);
+
+      if(!strcmp(upload.file_name,"0:/Robin_Nano35.bin") && !card.isFileOpen()){
+         DEBUG("Firmware found, reboot");
+         safe_delay(1000);
+         NVIC_SystemReset();
+      }
+   }else{
+      ui.set_status((const char *)"Upload failed",true);
+      BUZZ(436,392);
+      BUZZ(109,0);
+      BUZZ(436,392);
+      BUZZ(109,0);
+      BUZZ(436,392);
+   }
+}
+
+/*
+Если буфер полон и писать некуда, запись в файл целыми секторами.
+Возвращает 0 если все в порядке
+*/
+static uint8_t mks_wifi_upload_flush(void){
+   UINT bytes_writen=0;
+   uint32_t data_to_write;
+
+   if((file_data_size + ESP_PACKET_SIZE) <= FILE_BUFFER_SIZE) return 0;
+
+   data_to_write = (file_data_size / 512) * 512;
+   upload.file_inc_size += data_to_write;
+
+   res=f_write((FIL *)&upload_file,(uint8_t*)file_buff,data_to_write,&bytes_writen);
+   if(res){
+      ERROR("Write err %d",res);
+      return 1;
+   }
+
+   upload.file_size_writen += bytes_writen;
+   file_data_size -= data_to_write;
+   memcpy((uint8_t *)file_buff,(uint8_t *)(file_buff+data_to_write),file_data_size);
+
+   const uint8_t percent = upload.file_size ? (uint64_t)upload.file_size_writen * 100 / upload.file_size : 100;
+   if(percent != upload.percent){
+      char str[30];
+      sprintf(str,"Upload %d%%",percent);
+      ui.set_status((const char *)str);
+      upload.percent = percent;
+   }
+   return 0;
+}
+
+/*
+Сохраняет данные пакета в буфер файла.
+Сжатые фрагменты распаковываются heatshrink по мере приема.
+*/
+static uint8_t mks_wifi_upload_store(uint8_t *data, uint16_t size, bool compressed){
+   #if ENABLED(MKS_WIFI_COMPRESSED_UPLOAD)
+   if(compressed){
+      size_t sunk, polled;
+      HSD_poll_res presult;
+
+      while(size){
+         heatshrink_decoder_sink(&hsd, data, size, &sunk);
+         data += sunk;
+         size -= sunk;
+         do{
+            presult = heatshrink_decoder_poll(&hsd, (uint8_t *)file_buff+file_data_size, FILE_BUFFER_SIZE - file_data_size, &polled);
+            file_data_size += polled;
+            upload.file_received += polled;
+            if(mks_wifi_upload_flush()) return 1;
+         }while(presult == HSDR_POLL_MORE);
+      }
+      return 0;
+   }
+   #else
+   UNUSED(compressed);
+   #endif
+
+   memcpy((uint8_t *)file_buff+file_data_size,data,size);
+   file_data_size += size;
+   upload.file_received += size;
+   return mks_wifi_upload_flush();
+}
+
+/*
+Разбирает один принятый пакет.
+Возвращает 0 - продолжать прием, 1 - последний пакет, 2 - ошибка
+*/
+static uint8_t mks_wifi_upload_packet(uint8_t *data_packet){
+   uint16_t in_sector;
+   uint16_t data_size;
+
+   if(*data_packet != ESP_PROTOC_HEAD){
+      ERROR("Wrong packet head");
+      return 2;
+   }
+
+   in_sector = (*(data_packet+5) << 8) | *(data_packet+4);
+   if((in_sector - upload.last_sector) > 1){
+      ERROR("IN Sec: %d Prev sec: %d",in_sector,upload.last_sector);
+      return 2;
+   }
+   upload.last_sector = in_sector;
+
+   data_size = (*(data_packet+3) << 8) | *(data_packet+2);
+   data_size -= 4; //4 байта с номером сегмента и флагами
+
+   if(mks_wifi_upload_store(data_packet+8, data_size, *(data_packet+1) == ESP_TYPE_FILE_FRAGMENT_HS)) return 2;
+
+   if((in_sector == 0) && (upload.file_received == upload.file_size)){
+      DEBUG("1-packet file");
+      return 1;
+   }
+
+   return (*(data_packet+7) == 0x80) ? 1 : 0; //Последний пакет с данными
+}
+
+void mks_wifi_upload_idle(void){
+   static bool busy = false;
+
+   if(busy) return;
+
+   if(esp_reset_ms && ELAPSED(millis(), esp_reset_ms)){
+      WRITE(MKS_WIFI_IO_RST, HIGH);
+      esp_reset_ms = 0;
+   }
+
+   if(!upload.active) return;
+
+   busy = true;
+
+   uint8_t result = 0;
+   while(buffer_ready > 0 && result == 0){
+      result = mks_wifi_upload_packet((uint8_t *)dma_buff[upload.rd_index]);
+      upload.rd_index ^= 1;
+      upload.timeout_ms = millis() + MKS_WIFI_UPLOAD_TIMEOUT;
+
+      if(result) break;
+
+      #ifdef STM32F1
+      NVIC_DisableIRQ(DMA1_Channel5_IRQn);
+      #endif
+      #ifdef STM32F4
+      NVIC_DisableIRQ(DMA2_Stream5_IRQn);
+      #endif
+
+      --buffer_ready;
+      //Оба буфера были заняты, DMA ждет освободившийся буфер
+      if(dma_stopped == 1){
+         dma_buff_index ^= 1;
+         mks_wifi_dma_arm(dma_buff[dma_buff_index]);
+         dma_stopped = 0;
+      }
+      if(buffer_ready == 0) GPIOC->BSRR = GPIO_BSRR_BR7; //ESP может передавать дальше
+
+      #ifdef STM32F1
+      NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+      #endif
+      #ifdef STM32F4
+      NVIC_EnableIRQ(DMA2_Stream5_IRQn);
+      #endif
+   }
+
+   if(result == 1){
+      WRITE(MKS_WIFI_IO4, HIGH); //Остановить передачу от ESP
+      DEBUG("Last packet");
+      mks_wifi_upload_finish(false);
+   }else if(result == 2 || dma_stopped == 2 || ELAPSED(millis(), upload.timeout_ms)){
+      ERROR("Upload aborted");
+      mks_wifi_upload_finish(true);
+   }
+
+   busy = false;
+}
+
+void mks_wifi_start_file_upload(ESP_PROTOC_FRAME *packet){
+
+   if(upload.active){
+      ERROR("Upload already running");
+      return;
+   }
+
+   //FatFs и SdFat не могут писать на карту одновременно
+   if(card.isFileWrite()){
+      ERROR("SD file is open for writing");
+      ui.set_status((const char *)"SD busy: upload refused",true);
+      return;
+   }
+
+ 	//Установить имя файла. Смещение на 3 байта, чтобы добавить путь к диску
+   upload.file_name[0]='0';
+   upload.file_name[1]=':';
+   upload.file_name[2]='/';
+
+   memcpy((uint8_t *)upload.file_name+3,(uint8_t *)&packet->data[5],(packet->dataLen - 5));
+   upload.file_name[packet->dataLen - 5 + 3] = 0;
+
+   upload.file_size=(packet->data[4] << 24) | (packet->data[3] << 16) | (packet->data[2] << 8) | packet->data[1];
+   DEBUG("Start background file %s size %d",upload.file_name,upload.file_size);
+
+   if(mks_wifi_sd_init()){
+      ERROR("Error SD mount");
+      ui.set_status((const char *)"Error SD mount",true);
+      mks_wifi_sd_deinit();
+      return;
+   }
+
+   res=f_open((FIL *)&upload_file,upload.file_name,FA_CREATE_ALWAYS | FA_WRITE);
+   if(res){
+      ERROR("File open error %d",res);
+      ui.set_status((const char *)"File open error",true);
+      mks_wifi_sd_deinit();
+      return;
+   }
+
+   file_data_size = 0;
+   upload.file_received = 0;
+   upload.file_inc_size = 0;
+   upload.file_size_writen = 0;
+   upload.last_sector = 0;
+   upload.percent = 0;
+   upload.rd_index = 0;
+   upload.timeout_ms = millis() + MKS_WIFI_UPLOAD_TIMEOUT;
+
+   TERN_(MKS_WIFI_COMPRESSED_UPLOAD, heatshrink_decoder_reset(&hsd));
+   ui.set_status((const char *)"Upload 0%");
+
+   mks_wifi_rx_start();
+   upload.active = true;
+}
+
+#else
+
 void mks_wifi_start_file_upload(ESP_PROTOC_FRAME *packet){
 	char str[100];
    UINT bytes_writen=0;
@@ -460,6 +883,8 @@ void mks_wifi_start_file_upload(ESP_PROTOC_FRAME *packet){
    DEBUG("Restore thermal settings E0:%d Bed:%d",save_bed,save_e0);
 
 }
+#endif
+
 
 #ifdef STM32F1
 extern "C" void DMA1_Channel5_IRQHandler(void){
@@ -470,6 +895,19 @@ extern "C" void DMA1_Channel5_IRQHandler(void){
          DMA1->IFCR = DMA_CLEAR;
          return;
       }
+
+      #if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+      DMA1->IFCR = DMA_CLEAR;
+      GPIOC->BSRR = GPIO_BSRR_BS7;  //пауза ESP, пока буфер не записан на карту
+      buff=dma_buff[dma_buff_index];
+      if(++buffer_ready < 2){
+         dma_buff_index = (dma_buff_index) ? 0 : 1;
+         mks_wifi_dma_arm(dma_buff[dma_buff_index]);
+      }else{
+         dma_stopped=1; //свободного буфера нет, DMA перезапустится из idle
+      }
+      return;
+      #endif
       
       if(buffer_ready > 0){ 
          GPIOC->BSRR = GPIO_BSRR_BS7;  //остановить передачу от esp
@@ -499,6 +937,19 @@ extern "C" void DMA2_Stream5_IRQHandler(void){
          DMA2->HIFCR=DMA_S5_CLEAR;
          return;
       }
+
+      #if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+      DMA2->HIFCR=DMA_S5_CLEAR;
+      GPIOC->BSRR = GPIO_BSRR_BS7;  //пауза ESP, пока буфер не записан на карту
+      buff=dma_buff[dma_buff_index];
+      if(++buffer_ready < 2){
+         dma_buff_index = (dma_buff_index) ? 0 : 1;
+         mks_wifi_dma_arm(dma_buff[dma_buff_index]);
+      }else{
+         dma_stopped=1; //свободного буфера нет, DMA перезапустится из idle
+      }
+      return;
+      #endif
       
       if(buffer_ready > 0){ 
          GPIOC->BSRR = GPIO_BSRR_BS7;  //остановить передачу от esp
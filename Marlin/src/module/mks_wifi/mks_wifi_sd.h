@@ -49,6 +49,11 @@ uint8_t get_dos_filename(char *filename, char* dosfilename);
 
 void mks_wifi_start_file_upload(ESP_PROTOC_FRAME *packet);
 
+#if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+void mks_wifi_upload_idle(void);
+bool mks_wifi_upload_active(void);
+#endif
+
 #endif
 
 #endif
\ No newline at end of file
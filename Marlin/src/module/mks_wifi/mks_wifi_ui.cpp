@@ -66,6 +66,7 @@ void mks_upload_screen(char *filename, uint32_t file_size){
       // fit to 0.01 MB
       total_size = (float)file_size / 1048576;
       one_percent = total_size / 100;
+      tft.queue.damage_reset(); // The status screen is gone
       #ifndef SHOW_PROGRESS
         tft.queue.reset();
         tft.canvas(0, 0, TFT_WIDTH, TFT_HEIGHT);
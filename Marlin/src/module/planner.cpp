@@ -107,6 +107,10 @@
   #include "../feature/spindle_laser.h"
 #endif
 
+#if ENABLED(PLANNER_TELEMETRY)
+  #include "../feature/planner_telemetry.h"
+#endif
+
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100
@@ -124,6 +128,11 @@ volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be
                  Planner::block_buffer_planned, // Index of the optimally planned block
                  Planner::block_buffer_tail;    // Index of the busy block, if any
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
+
+#if ENABLED(BATCH_LINEAR_MOVES)
+  bool Planner::batch_open,                     // Moves are being added as a group
+       Planner::batch_pending;                  // Moves were added without planning them
+#endif
 uint8_t Planner::delay_before_delivering;       // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
 planner_settings_t Planner::settings;           // Initialized by settings.load()
@@ -963,7 +972,7 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
 
       const float new_entry_speed_sqr = TEST(current->flag, BLOCK_BIT_NOMINAL_LENGTH)
         ? max_entry_speed_sqr
-        : _MIN(max_entry_speed_sqr, max_allowable_speed_sqr(-current->acceleration, next ? next->entry_speed_sqr : sq(float(MINIMUM_PLANNER_SPEED)), current->millimeters));
+        : _MIN(max_entry_speed_sqr, (next ? next->entry_speed_sqr : sq(float(MINIMUM_PLANNER_SPEED))) + current->accel_speed_sqr);
       if (current->entry_speed_sqr != new_entry_speed_sqr) {
 
         // Need to recalculate the block speed - Mark it now, so the stepper
@@ -991,8 +1000,10 @@ void Planner::reverse_pass_kernel(block_t * const current, const block_t * const
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the reverse pass.
+ *
+ * Returns the index of the block where the forward pass should begin.
  */
-void Planner::reverse_pass() {
+uint8_t Planner::reverse_pass() {
   // Initialize block index to the last block in the planner buffer.
   uint8_t block_index = prev_block_index(block_buffer_head);
 
@@ -1003,7 +1014,7 @@ void Planner::reverse_pass() {
   // If there was a race condition and block_buffer_planned was incremented
   //  or was pointing at the head (queue empty) break loop now and avoid
   //  planning already consumed blocks
-  if (planned_block_index == block_buffer_head) return;
+  if (planned_block_index == block_buffer_head) return planned_block_index;
 
   // Reverse Pass: Coarsely maximize all possible deceleration curves back-planning from the last
   // block in buffer. Cease planning when the last optimal planned or tail pointer is reached.
@@ -1016,7 +1027,14 @@ void Planner::reverse_pass() {
 
     // Only consider non sync-and-page blocks
     if (!(current->flag & BLOCK_MASK_SYNC) && !IS_PAGE(current)) {
+      TERN_(PLANNER_TELEMETRY, planner_telemetry.block_visited());
       reverse_pass_kernel(current, next);
+
+      // The newest block always gets a new exit speed. Past it, a block whose entry speed
+      // didn't change leaves all the older blocks exactly as they were planned before.
+      // Stop here, and let the forward pass start from this block.
+      if (next && !TEST(current->flag, BLOCK_BIT_RECALCULATE)) return block_index;
+
       next = current;
     }
 
@@ -1029,12 +1047,14 @@ void Planner::reverse_pass() {
     while (planned_block_index != block_buffer_planned) {
 
       // If we reached the busy block or an already processed block, break the loop now
-      if (block_index == planned_block_index) return;
+      if (block_index == planned_block_index) return planned_block_index;
 
       // Advance the pointer, following the busy block
       planned_block_index = next_block_index(planned_block_index);
     }
   }
+
+  return planned_block_index;
 }
 
 // The kernel called by recalculate() when scanning the plan from first to last entry.
@@ -1048,7 +1068,7 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
       previous->entry_speed_sqr < current->entry_speed_sqr) {
 
       // Compute the maximum allowable speed
-      const float new_entry_speed_sqr = max_allowable_speed_sqr(-previous->acceleration, previous->entry_speed_sqr, previous->millimeters);
+      const float new_entry_speed_sqr = previous->entry_speed_sqr + previous->accel_speed_sqr;
 
       // If true, current block is full-acceleration and we can move the planned pointer forward.
       if (new_entry_speed_sqr < current->entry_speed_sqr) {
@@ -1091,7 +1111,7 @@ void Planner::forward_pass_kernel(const block_t * const previous, block_t * cons
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the forward pass.
  */
-void Planner::forward_pass() {
+void Planner::forward_pass(const uint8_t start_index) {
 
   // Forward Pass: Forward plan the acceleration curve from the planned pointer onward.
   // Also scans for optimal plan breakpoints and appropriately updates the planned pointer.
@@ -1102,6 +1122,11 @@ void Planner::forward_pass() {
   //  pass will never modify the values at the tail.
   uint8_t block_index = block_buffer_planned;
 
+  // Blocks before the one where the reverse pass stopped are already optimal.
+  // Skip them, unless the ISR moved the planned pointer past that block.
+  if (BLOCK_MOD(start_index - block_index) < BLOCK_MOD(block_buffer_head - block_index))
+    block_index = start_index;
+
   block_t *block;
   const block_t * previous = nullptr;
   while (block_index != block_buffer_head) {
@@ -1153,15 +1178,17 @@ void Planner::recalculate_trapezoids() {
   }
 
   // Go from the tail (currently executed block) to the first block, without including it)
+  // Entry speeds are only needed by the blocks being recalculated, so
+  // take the square roots on demand. Negative means not computed yet.
   block_t *block = nullptr, *next = nullptr;
-  float current_entry_speed = 0.0, next_entry_speed = 0.0;
+  float current_entry_speed = -1.0f, next_entry_speed = -1.0f;
   while (block_index != head_block_index) {
 
     next = &block_buffer[block_index];
 
     // Skip sync and page blocks
     if (!(next->flag & BLOCK_MASK_SYNC) && !IS_PAGE(next)) {
-      next_entry_speed = SQRT(next->entry_speed_sqr);
+      next_entry_speed = -1.0f;
 
       if (block) {
         // Recalculate if current block entry or exit junction speed has changed.
@@ -1178,10 +1205,14 @@ void Planner::recalculate_trapezoids() {
           if (!stepper.is_block_busy(block)) {
             // Block is not BUSY, we won the race against the Stepper ISR:
 
+            if (current_entry_speed < 0) current_entry_speed = SQRT(block->entry_speed_sqr);
+            next_entry_speed = SQRT(next->entry_speed_sqr);
+
             // NOTE: Entry and exit factors always > 0 by all previous logic operations.
             const float current_nominal_speed = SQRT(block->nominal_speed_sqr),
                         nomr = 1.0f / current_nominal_speed;
             calculate_trapezoid_for_block(block, current_entry_speed * nomr, next_entry_speed * nomr);
+            TERN_(PLANNER_TELEMETRY, planner_telemetry.block_replanned());
             #if ENABLED(LIN_ADVANCE)
               if (block->use_advance_lead) {
                 const float comp = block->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
@@ -1218,9 +1249,12 @@ void Planner::recalculate_trapezoids() {
     if (!stepper.is_block_busy(block)) {
       // Block is not BUSY, we won the race against the Stepper ISR:
 
+      if (next_entry_speed < 0) next_entry_speed = SQRT(next->entry_speed_sqr);
+
       const float next_nominal_speed = SQRT(next->nominal_speed_sqr),
                   nomr = 1.0f / next_nominal_speed;
       calculate_trapezoid_for_block(next, next_entry_speed * nomr, float(MINIMUM_PLANNER_SPEED) * nomr);
+      TERN_(PLANNER_TELEMETRY, planner_telemetry.block_replanned());
       #if ENABLED(LIN_ADVANCE)
         if (next->use_advance_lead) {
           const float comp = next->e_D_ratio * extruder_advance_K[active_extruder] * settings.axis_steps_per_mm[E_AXIS];
@@ -1237,14 +1271,19 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+  #if ENABLED(PLANNER_TELEMETRY)
+    const uint32_t recalculate_start = micros();
+    planner_telemetry.begin_recalculate();
+  #endif
+
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
   // If there is just one block, no planning can be done. Avoid it!
-  if (block_index != block_buffer_planned) {
-    reverse_pass();
-    forward_pass();
-  }
+  if (block_index != block_buffer_planned)
+    forward_pass(reverse_pass());
   recalculate_trapezoids();
+
+  TERN_(PLANNER_TELEMETRY, planner_telemetry.end_recalculate(micros() - recalculate_start));
 }
 
 #if HAS_FAN && DISABLED(LASER_SYNCHRONOUS_M106_M107)
@@ -1668,6 +1707,7 @@ void Planner::quick_stop() {
 
   // Drop all queue entries
   block_buffer_nonbusy = block_buffer_planned = block_buffer_head = block_buffer_tail;
+  TERN_(BATCH_LINEAR_MOVES, batch_pending = false);
 
   // Restart the block delay for the first movement - As the queue was
   // forced to empty, there's no risk the ISR will touch this.
@@ -1775,7 +1815,10 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
 /**
  * Block until the planner is finished processing
  */
-void Planner::synchronize() { while (busy()) idle(); }
+void Planner::synchronize() {
+  TERN_(BATCH_LINEAR_MOVES, flush_batch()); // Unplanned blocks would never run
+  while (busy() || TERN0(INPUT_SHAPING, !stepper.shaping_idle())) idle(); // Wait for delayed steps too
+}
 
 /**
  * Planner::_buffer_steps
@@ -1826,9 +1869,23 @@ bool Planner::_buffer_steps(const xyze_long_t &target
     delay_before_delivering = BLOCK_DELAY_FOR_1ST_MOVE;
   }
 
+  // Sample the queue depth the new block joins
+  TERN_(PLANNER_TELEMETRY, planner_telemetry.queue_depth(movesplanned()));
+
   // Move buffer head
   block_buffer_head = next_buffer_head;
 
+  // In a batch, plan the whole group at the end. But not if the
+  // buffer is full, as the next move would wait for the stepper,
+  // nor if the buffer is nearly drained, as the stepper would starve.
+  #if ENABLED(BATCH_LINEAR_MOVES)
+    if (batch_open && moves_free() && movesplanned() > 2) {
+      batch_pending = true;
+      return true;
+    }
+    batch_pending = false;
+  #endif
+
   // Recalculate and optimize trapezoidal speed profiles
   recalculate();
 
@@ -2488,6 +2545,9 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   }
   block->acceleration_steps_per_s2 = accel;
   block->acceleration = accel / steps_per_mm;
+
+  // Cache max_allowable_speed_sqr() terms for the look-ahead passes
+  block->accel_speed_sqr = max_allowable_speed_sqr(-block->acceleration, 0, block->millimeters);
   #if DISABLED(S_CURVE_ACCELERATION)
     block->acceleration_rate = (uint32_t)(accel * (sq(4096.0f) / (STEPPER_TIMER_RATE)));
   #endif
@@ -2505,6 +2565,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
   float vmax_junction_sqr; // Initial limit on the segment entry velocity (mm/s)^2
 
+  #if ENABLED(PLANNER_TELEMETRY)
+    // The limit that binds last is counted once vmax_junction_sqr is final
+    bool junction_counted = false;
+    PlannerClamp clamp_why = PLANNER_CLAMP_NOMINAL;
+  #endif
+
   #if HAS_JUNCTION_DEVIATION
     /**
      * Compute maximum allowable entry speed at junction by centripetal acceleration approximation.
@@ -2564,6 +2630,11 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
     // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
     if (moves_queued && !UNEAR_ZERO(previous_nominal_speed_sqr)) {
+      #if ENABLED(PLANNER_TELEMETRY)
+        junction_counted = true;
+        clamp_why = PLANNER_CLAMP_DEVIATION;
+      #endif
+
       // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
       // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
       float junction_cos_theta = LOGICAL_AXIS_GANG(
@@ -2676,6 +2747,9 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
             #endif
 
             const float limit_sqr = (block->millimeters * junction_acceleration) / junction_theta;
+            #if ENABLED(PLANNER_TELEMETRY)
+              if (limit_sqr < vmax_junction_sqr) clamp_why = PLANNER_CLAMP_SEGMENT;
+            #endif
             NOMORE(vmax_junction_sqr, limit_sqr);
           }
 
@@ -2683,6 +2757,9 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       }
 
       // Get the lowest speed
+      #if ENABLED(PLANNER_TELEMETRY)
+        if (_MIN(block->nominal_speed_sqr, previous_nominal_speed_sqr) <= vmax_junction_sqr) clamp_why = PLANNER_CLAMP_NOMINAL;
+      #endif
       vmax_junction_sqr = _MIN(vmax_junction_sqr, block->nominal_speed_sqr, previous_nominal_speed_sqr);
     }
     else // Init entry speed to zero. Assume it starts from rest. Planner will correct this later.
@@ -2782,6 +2859,10 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         }
       }
       if (limited) vmax_junction *= v_factor;
+      #if ENABLED(PLANNER_TELEMETRY) && !HAS_JUNCTION_DEVIATION
+        junction_counted = true;
+        clamp_why = limited ? PLANNER_CLAMP_JERK : PLANNER_CLAMP_NOMINAL;
+      #endif
       // Now the transition velocity is known, which maximizes the shared exit / entry velocity while
       // respecting the jerk factors, it may be possible, that applying separate safe exit / entry velocities will achieve faster prints.
       const float vmax_junction_threshold = vmax_junction * 0.99f;
@@ -2794,6 +2875,9 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
     previous_safe_speed = safe_speed;
 
     #if HAS_JUNCTION_DEVIATION
+      #if ENABLED(PLANNER_TELEMETRY)
+        if (sq(vmax_junction) < vmax_junction_sqr) clamp_why = PLANNER_CLAMP_JERK;
+      #endif
       NOMORE(vmax_junction_sqr, sq(vmax_junction));   // Throttle down to max speed
     #else
       vmax_junction_sqr = sq(vmax_junction);          // Go up or down to the new speed
@@ -2801,11 +2885,18 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
   #endif // Classic Jerk Limiting
 
+  #if ENABLED(PLANNER_TELEMETRY)
+    if (junction_counted) {
+      planner_telemetry.junction();
+      planner_telemetry.clamp(clamp_why);
+    }
+  #endif
+
   // Max entry speed of this block equals the max exit speed of the previous block.
   block->max_entry_speed_sqr = vmax_junction_sqr;
 
   // Initialize block entry speed. Compute based on deceleration to user-defined MINIMUM_PLANNER_SPEED.
-  const float v_allowable_sqr = max_allowable_speed_sqr(-block->acceleration, sq(float(MINIMUM_PLANNER_SPEED)), block->millimeters);
+  const float v_allowable_sqr = sq(float(MINIMUM_PLANNER_SPEED)) + block->accel_speed_sqr;
 
   // If we are trying to add a split block, start with the
   // max. allowed speed to avoid an interrupted first move.
@@ -174,7 +174,8 @@ typedef struct block_t {
         entry_speed_sqr,                    // Entry speed at previous-current junction in (mm/sec)^2
         max_entry_speed_sqr,                // Maximum allowable junction entry speed in (mm/sec)^2
         millimeters,                        // The total travel of this block in mm
-        acceleration;                       // acceleration mm/sec^2
+        acceleration,                       // acceleration mm/sec^2
+        accel_speed_sqr;                    // Speed^2 gained accelerating over the whole block (2 * acceleration * millimeters)
 
   union {
     abce_ulong_t steps;                     // Step count along each axis
@@ -352,6 +353,11 @@ class Planner {
     static uint16_t cleaning_buffer_counter;        // A counter to disable queuing of blocks
     static uint8_t delay_before_delivering;         // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
+    #if ENABLED(BATCH_LINEAR_MOVES)
+      static bool batch_open,                       // Moves are being added as a group
+                  batch_pending;                    // Moves were added without planning them
+    #endif
+
 
     #if ENABLED(DISTINCT_E_FACTORS)
       static uint8_t last_extruder;                 // Respond to extruder change
@@ -891,6 +897,17 @@ class Planner {
     // Block until all buffered steps are executed / cleaned
     static void synchronize();
 
+    #if ENABLED(BATCH_LINEAR_MOVES)
+      /**
+       * Add a group of moves and plan them once, at end_batch(). The new blocks
+       * aren't handed to the stepper until then, so keep groups short. Planning
+       * happens early if the buffer fills up or something waits for the moves.
+       */
+      static void begin_batch() { batch_open = true; }
+      static void end_batch() { batch_open = false; flush_batch(); }
+      static void flush_batch() { if (batch_pending) { batch_pending = false; recalculate(); } }
+    #endif
+
     // Wait for moves to finish and disable all steppers
     static void finish_and_disable();
 
@@ -1005,8 +1022,8 @@ class Planner {
     static void reverse_pass_kernel(block_t * const current, const block_t * const next);
     static void forward_pass_kernel(const block_t * const previous, block_t * const current, uint8_t block_index);
 
-    static void reverse_pass();
-    static void forward_pass();
+    static uint8_t reverse_pass();
+    static void forward_pass(const uint8_t start_index);
 
     static void recalculate_trapezoids();
 
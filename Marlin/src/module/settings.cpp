@@ -428,6 +428,13 @@ typedef struct SettingsDataStruct {
   //
   float planner_extruder_advance_K[_MAX(EXTRUDERS, 1)]; // M900 K  planner.extruder_advance_K
 
+  //
+  // INPUT_SHAPING
+  //
+  #if ENABLED(INPUT_SHAPING)
+    shaping_settings_t shaping_settings[2];             // M593 X Y F D T  stepper.shaping_settings
+  #endif
+
   //
   // HAS_MOTOR_CURRENT_PWM
   //
@@ -598,9 +605,18 @@ void MarlinSettings::postprocess() {
   TERN_(ENABLE_LEVELING_FADE_HEIGHT, set_z_fade_height(new_z_fade_height, false)); // false = no report
 
   TERN_(AUTO_BED_LEVELING_BILINEAR, refresh_bed_level());
+  TERN_(MBL_CELL_TABLE, mbl.refresh_cells());
 
   TERN_(HAS_MOTOR_CURRENT_PWM, stepper.refresh_motor_power());
 
+  #if ENABLED(RS_ADDSETTINGS)
+    stepper.refresh_dir_levels();
+    endstops.refresh_inverting();
+    TERN_(THERMISTOR_LUT, thermalManager.refresh_thermistor_luts());
+  #endif
+
+  TERN_(INPUT_SHAPING, stepper.refresh_shaping()); // After refresh_dir_levels
+
   TERN_(FWRETRACT, fwretract.refresh_autoretract());
 
   TERN_(HAS_LINEAR_E_JERK, planner.recalculate_max_e_jerk());
@@ -1358,6 +1374,14 @@ void MarlinSettings::postprocess() {
       #endif
     }
 
+    //
+    // Input Shaping
+    //
+    #if ENABLED(INPUT_SHAPING)
+      _FIELD_TEST(shaping_settings);
+      EEPROM_WRITE(stepper.shaping_settings);
+    #endif
+
     //
     // Motor Current PWM
     //
@@ -2296,6 +2320,18 @@ void MarlinSettings::postprocess() {
         #endif
       }
 
+      //
+      // Input Shaping
+      //
+      #if ENABLED(INPUT_SHAPING)
+      {
+        shaping_settings_t shaping_settings[2];
+        _FIELD_TEST(shaping_settings);
+        EEPROM_READ(shaping_settings);
+        if (!validating) COPY(stepper.shaping_settings, shaping_settings);
+      }
+      #endif
+
       //
       // Motor Current PWM
       //
@@ -3226,6 +3262,15 @@ void MarlinSettings::reset() {
     }
   #endif
 
+  //
+  // Input Shaping
+  //
+
+  #if ENABLED(INPUT_SHAPING)
+    stepper.shaping_settings[0] = { SHAPING_FREQ_X, SHAPING_ZETA_X, SHAPING_TYPE_X };
+    stepper.shaping_settings[1] = { SHAPING_FREQ_Y, SHAPING_ZETA_Y, SHAPING_TYPE_Y };
+  #endif
+
   //
   // Motor Current PWM
   //
@@ -3541,6 +3586,11 @@ void MarlinSettings::reset() {
     //
     TERN_(LIN_ADVANCE, gcode.M900_report(forReplay));
 
+    //
+    // Input Shaping
+    //
+    TERN_(INPUT_SHAPING, gcode.M593_report(forReplay));
+
     //
     // Motor Current (SPI or PWM)
     //
@@ -139,6 +139,12 @@ Stepper stepper; // Singleton
   #include "../lcd/extui/ui_api.h"
 #endif
 
+#if ENABLED(STEPPER_ISR_PROFILING)
+  #include "../feature/isr_profiler.h"
+#else
+  #define ISR_PROFILE(PHASE, STATEMENT) STATEMENT
+#endif
+
 // public:
 
 #if EITHER(HAS_EXTRA_ENDSTOPS, Z_STEPPER_AUTO_ALIGN)
@@ -162,6 +168,10 @@ block_t* Stepper::current_block; // (= nullptr) A pointer to the block currently
 axis_bits_t Stepper::last_direction_bits, // = 0
             Stepper::axis_did_move; // = 0
 
+#if ENABLED(RS_ADDSETTINGS)
+  axis_bits_t Stepper::forward_dir_levels;
+#endif
+
 bool Stepper::abort_current_block;
 
 #if DISABLED(MIXING_EXTRUDER) && HAS_MULTI_EXTRUDER
@@ -244,6 +254,13 @@ uint32_t Stepper::advance_divisor = 0,
   page_step_state_t Stepper::page_step_state;
 #endif
 
+#if ENABLED(INPUT_SHAPING)
+  shaping_settings_t Stepper::shaping_settings[2];
+  ShapedAxis Stepper::shaping_x, Stepper::shaping_y;
+  uint32_t Stepper::shaping_now, // = 0
+           Stepper::nextShapingISR = SHAPING_NEVER;
+#endif
+
 int32_t Stepper::ticks_nominal = -1;
 #if DISABLED(S_CURVE_ACCELERATION)
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
@@ -488,6 +505,24 @@ xyze_int8_t Stepper::count_direction{0};
   #define DIR_WAIT_AFTER()
 #endif
 
+#if ENABLED(INPUT_SHAPING)
+  // DIR pin level for a shaped step
+  #if ENABLED(RS_ADDSETTINGS)
+    #define SHAPED_DIR_LEVEL(A, REV) (TEST(Stepper::forward_dir_levels, _AXIS(A)) != (REV))
+  #else
+    #define SHAPED_DIR_LEVEL(A, REV) ((REV) ? INVERT_##A##_DIR : !INVERT_##A##_DIR)
+  #endif
+
+  // Point a shaped axis in the direction of its next step
+  #define SHAPED_SET_DIR(A, SA, REV) do{ \
+    if ((REV) != SA.reverse) { \
+      SA.reverse = (REV); \
+      A##_APPLY_DIR(SHAPED_DIR_LEVEL(A, SA.reverse), false); \
+      DIR_WAIT_AFTER(); \
+    } \
+  }while(0)
+#endif
+
 void Stepper::enable_axis(const AxisEnum axis) {
   #define _CASE_ENABLE(N) case N##_AXIS: ENABLE_AXIS_##N(); break;
   switch (axis) {
@@ -571,6 +606,20 @@ void Stepper::disable_all_steppers() {
   TERN_(EXTENSIBLE_UI, ExtUI::onSteppersDisabled());
 }
 
+#if ENABLED(RS_ADDSETTINGS)
+
+  /**
+   * Fold the runtime direction inversion into one mask, so set_directions()
+   * gets every DIR level with a single XOR instead of a lookup per axis.
+   */
+  void Stepper::refresh_dir_levels() {
+    axis_bits_t levels = 0;
+    LOOP_L_N(i, LOGICAL_AXES) if (!planner.invert_axis.invert_axis[i]) SBI(levels, i);
+    forward_dir_levels = levels;
+  }
+
+#endif
+
 /**
  * Set the stepper direction of each axis
  *
@@ -582,24 +631,27 @@ void Stepper::set_directions() {
 
   DIR_WAIT_BEFORE();
 
+  // The shaper sets the DIR pin of a shaped axis as its steps go out
+  #if ENABLED(INPUT_SHAPING)
+    #define _DIR_IS_SHAPED(A) ((_AXIS(A) == X_AXIS && shaping_x.enabled) || (_AXIS(A) == Y_AXIS && shaping_y.enabled))
+  #else
+    #define _DIR_IS_SHAPED(A) false
+  #endif
+
   #if ENABLED(RS_ADDSETTINGS)
+    // Reverse axes flip their forward level
+    const axis_bits_t dir_levels = last_direction_bits ^ forward_dir_levels;
     #define SET_STEP_DIR(A)                       \
-      if (motor_direction(_AXIS(A))) {            \
-        A##_APPLY_DIR(planner.invert_axis.invert_axis[_AXIS(A)], false);   \
-        count_direction[_AXIS(A)] = -1;           \
-      }                                           \
-      else {                                      \
-        A##_APPLY_DIR(!planner.invert_axis.invert_axis[_AXIS(A)], false);  \
-        count_direction[_AXIS(A)] = 1;            \
-      }
+      if (!_DIR_IS_SHAPED(A)) A##_APPLY_DIR(TEST(dir_levels, _AXIS(A)), false); \
+      count_direction[_AXIS(A)] = motor_direction(_AXIS(A)) ? -1 : 1;
   #else
   #define SET_STEP_DIR(A)                       \
     if (motor_direction(_AXIS(A))) {            \
-      A##_APPLY_DIR(INVERT_##A##_DIR, false);   \
+      if (!_DIR_IS_SHAPED(A)) A##_APPLY_DIR(INVERT_##A##_DIR, false); \
       count_direction[_AXIS(A)] = -1;           \
     }                                           \
     else {                                      \
-      A##_APPLY_DIR(!INVERT_##A##_DIR, false);  \
+      if (!_DIR_IS_SHAPED(A)) A##_APPLY_DIR(!INVERT_##A##_DIR, false); \
       count_direction[_AXIS(A)] = 1;            \
     }
   #endif  // RS_ADDSETTINGS
@@ -1487,6 +1539,8 @@ void Stepper::isr() {
 
   static uint32_t nextMainISR = 0;  // Interval until the next main Stepper Pulse phase (0 = Now)
 
+  TERN_(STEPPER_ISR_PROFILING, const uint32_t isr_start = ISRProfiler::cycles());
+
   #ifndef __AVR__
     // Disable interrupts, to avoid ISR preemption while we reprogram the period
     // (AVR enters the ISR with global interrupts disabled, so no need to do it here)
@@ -1510,20 +1564,28 @@ void Stepper::isr() {
     // Enable ISRs to reduce USART processing latency
     ENABLE_ISRS();
 
-    if (!nextMainISR) pulse_phase_isr();                            // 0 = Do coordinated axes Stepper pulses
+    if (!nextMainISR) ISR_PROFILE(ISR_PHASE_PULSE, pulse_phase_isr());                            // 0 = Do coordinated axes Stepper pulses
+
+    #if ENABLED(INPUT_SHAPING)
+      if (!nextShapingISR) shaping_isr();                                                         // 0 = Do delayed X/Y Stepper pulses
+    #endif
 
     #if ENABLED(LIN_ADVANCE)
-      if (!nextAdvanceISR) nextAdvanceISR = advance_isr();          // 0 = Do Linear Advance E Stepper pulses
+      if (!nextAdvanceISR) ISR_PROFILE(ISR_PHASE_ADVANCE, nextAdvanceISR = advance_isr());          // 0 = Do Linear Advance E Stepper pulses
     #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       const bool is_babystep = (nextBabystepISR == 0);              // 0 = Do Babystepping (XY)Z pulses
-      if (is_babystep) nextBabystepISR = babystepping_isr();
+      if (is_babystep) ISR_PROFILE(ISR_PHASE_BABYSTEP, nextBabystepISR = babystepping_isr());
     #endif
 
     // ^== Time critical. NOTHING besides pulse generation should be above here!!!
 
-    if (!nextMainISR) nextMainISR = block_phase_isr();  // Manage acc/deceleration, get next block
+    if (!nextMainISR) ISR_PROFILE(ISR_PHASE_BLOCK, nextMainISR = block_phase_isr());  // Manage acc/deceleration, get next block
+
+    #if ENABLED(INPUT_SHAPING)
+      nextShapingISR = _MIN(shaping_x.next_due(shaping_now), shaping_y.next_due(shaping_now));
+    #endif
 
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       if (is_babystep)                                  // Avoid ANY stepping too soon after baby-stepping
@@ -1539,6 +1601,7 @@ void Stepper::isr() {
       nextMainISR                                       // Time until the next Pulse / Block phase
       OPTARG(LIN_ADVANCE, nextAdvanceISR)               // Come back early for Linear Advance?
       OPTARG(INTEGRATED_BABYSTEPPING, nextBabystepISR)  // Come back early for Babystepping?
+      OPTARG(INPUT_SHAPING, nextShapingISR)             // Come back early for delayed steps?
     );
 
     //
@@ -1558,6 +1621,11 @@ void Stepper::isr() {
       if (nextBabystepISR != BABYSTEP_NEVER) nextBabystepISR -= interval;
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      if (nextShapingISR != SHAPING_NEVER) nextShapingISR -= interval;
+      shaping_now += interval;
+    #endif
+
     /**
      * This needs to avoid a race-condition caused by interleaving
      * of interrupts required by both the LA and Stepper algorithms.
@@ -1626,6 +1694,8 @@ void Stepper::isr() {
   // Set the next ISR to fire at the proper time
   HAL_timer_set_compare(MF_TIMER_STEP, hal_timer_t(next_isr_ticks));
 
+  TERN_(STEPPER_ISR_PROFILING, ISRProfiler::record(ISR_PHASE_TOTAL, ISRProfiler::cycles() - isr_start));
+
   // Don't forget to finally reenable interrupts
   ENABLE_ISRS();
 }
@@ -1686,6 +1756,21 @@ void Stepper::pulse_phase_isr() {
       } \
     }while(0)
 
+    #if ENABLED(INPUT_SHAPING)
+      // Give a planned step to the shaper, which may send a step out now
+      #define SHAPED_PULSE_PREP(AXIS, SA) do{ \
+        if (!SA.enabled) { PULSE_PREP(AXIS); break; } \
+        delta_error[_AXIS(AXIS)] += advance_dividend[_AXIS(AXIS)]; \
+        step_needed[_AXIS(AXIS)] = false; \
+        if (delta_error[_AXIS(AXIS)] >= 0) { \
+          count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
+          delta_error[_AXIS(AXIS)] -= advance_divisor; \
+          const int8_t dir = SA.step(shaping_now, motor_direction(_AXIS(AXIS))); \
+          if (dir) { SHAPED_SET_DIR(AXIS, SA, dir < 0); step_needed[_AXIS(AXIS)] = true; } \
+        } \
+      }while(0)
+    #endif
+
     // Start an active pulse if needed
     #define PULSE_START(AXIS) do{ \
       if (step_needed[_AXIS(AXIS)]) { \
@@ -1812,10 +1897,10 @@ void Stepper::pulse_phase_isr() {
     if (!is_page) {
       // Determine if pulses are needed
       #if HAS_X_STEP
-        PULSE_PREP(X);
+        TERN(INPUT_SHAPING, SHAPED_PULSE_PREP(X, shaping_x), PULSE_PREP(X));
       #endif
       #if HAS_Y_STEP
-        PULSE_PREP(Y);
+        TERN(INPUT_SHAPING, SHAPED_PULSE_PREP(Y, shaping_y), PULSE_PREP(Y));
       #endif
       #if HAS_Z_STEP
         PULSE_PREP(Z);
@@ -2521,6 +2606,106 @@ uint32_t Stepper::block_phase_isr() {
 
 #endif // LIN_ADVANCE
 
+#if ENABLED(INPUT_SHAPING)
+
+  // Timer interrupt for the delayed impulses of shaped X and Y steps
+  void Stepper::shaping_isr() {
+
+    #if ISR_PULSE_CONTROL
+      // The pulse phase may have just stepped
+      USING_TIMED_PULSE();
+      START_LOW_PULSE();
+    #endif
+
+    #define SHAPED_PULSES(A, SA) \
+      LOOP_L_N(t, 2) while (SA.due(shaping_now, t)) { \
+        const int8_t dir = SA.pop(t); \
+        if (!dir) continue; \
+        TERN_(ISR_PULSE_CONTROL, AWAIT_LOW_PULSE()); \
+        SHAPED_SET_DIR(A, SA, dir < 0); \
+        A##_APPLY_STEP(!INVERT_##A##_STEP_PIN, 0); \
+        TERN_(ISR_PULSE_CONTROL, START_HIGH_PULSE()); \
+        TERN_(ISR_PULSE_CONTROL, AWAIT_HIGH_PULSE()); \
+        A##_APPLY_STEP(INVERT_##A##_STEP_PIN, 0); \
+        TERN_(ISR_PULSE_CONTROL, START_LOW_PULSE()); \
+      }
+
+    SHAPED_PULSES(X, shaping_x);
+    SHAPED_PULSES(Y, shaping_y);
+  }
+
+  /**
+   * Set the impulses of a shaped axis for its frequency and damping,
+   * with Td the damped period of ringing:
+   *
+   *   ZV  : 2 impulses over Td/2
+   *   ZVD : 3 impulses over Td
+   *   MZV : 3 impulses over 3/4 Td, between ZV and ZVD
+   *   EI  : 3 impulses over Td, allowing 5% vibration to widen the band
+   */
+  static void set_shaper(ShapedAxis &sa, const shaping_settings_t &ss) {
+    sa.enabled = ss.frequency > 0;
+    if (!sa.enabled) return;
+
+    const float zeta = constrain(ss.zeta, 0, 0.99f),
+                df = SQRT(1 - sq(zeta)),
+                K = expf(-zeta * float(M_PI) / df),
+                Td = 1 / (ss.frequency * df);
+
+    float a[3], t[3] = { 0, 0.5f * Td, Td };
+    switch (ss.type) {
+      default:
+      case SHAPER_ZV:  a[0] = 1; a[1] = K; a[2] = 0; t[2] = t[1]; break;
+      case SHAPER_ZVD: a[0] = 1; a[1] = 2 * K; a[2] = sq(K); break;
+      case SHAPER_MZV: {
+        const float K2 = expf(-0.75f * zeta * float(M_PI) / df);
+        a[0] = 1 - 0.70710678f; a[1] = 0.41421356f * K2; a[2] = a[0] * sq(K2);
+        t[1] = 0.375f * Td; t[2] = 0.75f * Td;
+      } break;
+      case SHAPER_EI: {
+        constexpr float v = 0.05f;          // Tolerated vibration
+        a[0] = 0.25f * (1 + v); a[1] = 0.5f * (1 - v) * K; a[2] = a[0] * sq(K);
+      } break;
+    }
+
+    // Amplitudes in impulse units, with any rounding left in the first impulse
+    const float scale = (SHAPING_ONE) / (a[0] + a[1] + a[2]);
+    sa.factor[1] = LROUND(a[1] * scale);
+    sa.factor[2] = LROUND(a[2] * scale);
+    sa.factor[0] = (SHAPING_ONE) - sa.factor[1] - sa.factor[2];
+    LOOP_L_N(i, 3) sa.delay[i] = LROUND(t[i] * (STEPPER_TIMER_RATE));
+  }
+
+  /**
+   * Apply shaping_settings to the X and Y axes. Waits for motion to end,
+   * since the queued impulses are dropped and the DIR pins reset.
+   */
+  void Stepper::refresh_shaping() {
+    planner.synchronize();
+
+    // CoreXY motors each move both axes, so a shaper is only valid if both motors share it
+    TERN_(CORE_IS_XY, shaping_settings[1] = shaping_settings[0]);
+
+    const bool was_enabled = suspend(),
+               x_was_shaped = shaping_x.enabled,
+               y_was_shaped = shaping_y.enabled;
+
+    set_shaper(shaping_x, shaping_settings[0]);
+    set_shaper(shaping_y, shaping_settings[1]);
+    shaping_x.reset();
+    shaping_y.reset();
+    shaping_x.reverse = motor_direction(X_AXIS);
+    shaping_y.reverse = motor_direction(Y_AXIS);
+
+    // The shaper left the DIR pin where its last step went
+    if (x_was_shaped) X_APPLY_DIR(SHAPED_DIR_LEVEL(X, shaping_x.reverse), false);
+    if (y_was_shaped) Y_APPLY_DIR(SHAPED_DIR_LEVEL(Y, shaping_y.reverse), false);
+
+    if (was_enabled) wake_up();
+  }
+
+#endif // INPUT_SHAPING
+
 #if ENABLED(INTEGRATED_BABYSTEPPING)
 
   // Timer interrupt for baby-stepping
@@ -2792,6 +2977,7 @@ void Stepper::init() {
 
   // Init direction bits for first moves
 #if ENABLED(RS_ADDSETTINGS)
+  refresh_dir_levels();
   set_directions((planner.invert_axis.invert_axis[X_AXIS]  ? 1 << X_AXIS : 0)
                 | (planner.invert_axis.invert_axis[Y_AXIS] ? 1 << Y_AXIS : 0)
                 | (planner.invert_axis.invert_axis[Z_AXIS] ? 1 << Z_AXIS : 0)
@@ -45,6 +45,9 @@
 
 #include "planner.h"
 #include "stepper/indirection.h"
+#if ENABLED(INPUT_SHAPING)
+  #include "stepper/input_shaping.h"
+#endif
 #ifdef __AVR__
   #include "speed_lookuptable.h"
 #endif
@@ -337,6 +340,17 @@ class Stepper {
       static bool frozen;                   // Set this flag to instantly freeze motion
     #endif
 
+    #if ENABLED(RS_ADDSETTINGS)
+      static axis_bits_t forward_dir_levels; // DIR pin level per axis for forward motion, from planner.invert_axis
+      static void refresh_dir_levels();      // Call after changing planner.invert_axis
+    #endif
+
+    #if ENABLED(INPUT_SHAPING)
+      static shaping_settings_t shaping_settings[2]; // X and Y, set by M593
+      static void refresh_shaping();                 // Apply shaping_settings, after motion ends
+      static bool shaping_idle() { return shaping_x.idle() && shaping_y.idle(); }
+    #endif
+
   private:
 
     static block_t* current_block;          // A pointer to the block currently being traced
@@ -416,6 +430,12 @@ class Stepper {
       static page_step_state_t page_step_state;
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      static ShapedAxis shaping_x, shaping_y;
+      static uint32_t shaping_now,          // Stepper timer ticks, as counted by the ISR
+                      nextShapingISR;
+    #endif
+
     static int32_t ticks_nominal;
     #if DISABLED(S_CURVE_ACCELERATION)
       static uint32_t acc_step_rate; // needed for deceleration start point
@@ -482,6 +502,11 @@ class Stepper {
       FORCE_INLINE static void initiateLA() { nextAdvanceISR = 0; }
     #endif
 
+    #if ENABLED(INPUT_SHAPING)
+      // The Input Shaping ISR phase, for delayed X and Y steps
+      static void shaping_isr();
+    #endif
+
     #if ENABLED(INTEGRATED_BABYSTEPPING)
       // The Babystepping ISR phase
       static uint32_t babystepping_isr();
@@ -654,8 +654,8 @@ void reset_stepper_drivers();    // Called by settings.load / settings.reset
 #elif E_STEPPERS
   #define E_STEP_WRITE(E,V) E0_STEP_WRITE(V)
   #if ENABLED(RS_ADDSETTINGS)
-    #define   NORM_E_DIR(E)   E0_DIR_WRITE(!planner.invert_axis.invert_axis[E_AXIS])
-    #define    REV_E_DIR(E)   E0_DIR_WRITE( planner.invert_axis.invert_axis[E_AXIS])
+    #define   NORM_E_DIR(E)   E0_DIR_WRITE( TEST(Stepper::forward_dir_levels, E_AXIS))
+    #define    REV_E_DIR(E)   E0_DIR_WRITE(!TEST(Stepper::forward_dir_levels, E_AXIS))
   #else
   #define   NORM_E_DIR(E)   E0_DIR_WRITE(!INVERT_E0_DIR)
   #define    REV_E_DIR(E)   E0_DIR_WRITE( INVERT_E0_DIR)
@@ -0,0 +1,105 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2022 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * stepper/input_shaping.h
+ *
+ * Input shaping for the X and Y steppers.
+ *
+ * Each step of the planned stream is split into three impulses: a share
+ * of the step right away and the rest after one or two delays. A shaped
+ * step goes out whenever the shares owed add up to half a step, so the
+ * step count is exact and only the timing is spread over the shaper.
+ * Impulse amplitudes and delays are chosen to cancel the ringing at the
+ * axis' resonant frequency.
+ */
+
+#include "../../inc/MarlinConfigPre.h"
+
+enum ShaperType : uint8_t { SHAPER_ZV, SHAPER_ZVD, SHAPER_MZV, SHAPER_EI, SHAPER_COUNT };
+
+typedef struct {
+  float frequency;  // (Hz) 0 = Off
+  float zeta;       // Damping ratio
+  uint8_t type;     // ShaperType
+} shaping_settings_t;
+
+#define SHAPING_ONE   256                   // A whole step, in impulse units
+#define SHAPING_NEVER 0xFFFFFFFFUL
+
+class ShapedAxis {
+public:
+  bool enabled;
+  bool reverse;                             // Direction of the last shaped step
+  uint16_t factor[3];                       // Impulse amplitudes, summing to SHAPING_ONE
+  uint32_t delay[3];                        // Impulse delays in stepper timer ticks
+  int16_t owed;                             // Impulses not yet stepped, in SHAPING_ONE units
+
+  // Planned steps: time in ticks, with bit 0 set for reverse
+  uint32_t events[SHAPING_BUFFER_SIZE];
+  uint16_t head, tail[2];                   // One tail for each delayed impulse
+
+  void reset() { owed = 0; head = tail[0] = tail[1] = 0; }
+
+  // No delayed impulses remain
+  bool idle() const { return tail[1] == head; }
+
+  // Add an impulse, returning the direction of a step to take (or 0)
+  int8_t impulse(const bool rev, const int16_t amount) {
+    owed += rev ? -amount : amount;
+    if (owed >= SHAPING_ONE / 2) { owed -= SHAPING_ONE; return 1; }
+    if (owed < -(SHAPING_ONE / 2)) { owed += SHAPING_ONE; return -1; }
+    return 0;
+  }
+
+  // A planned step: queue its delayed impulses and take the first one
+  int8_t step(const uint32_t now, const bool rev) {
+    const uint16_t next = (head + 1) & (SHAPING_BUFFER_SIZE - 1);
+    if (next == tail[1]) return impulse(rev, SHAPING_ONE); // Queue full: step unshaped
+    events[head] = (now & ~1UL) | rev;
+    head = next;
+    return impulse(rev, factor[0]);
+  }
+
+  // The oldest event on tail t is due for its delayed impulse
+  bool due(const uint32_t now, const uint8_t t) const {
+    return tail[t] != head && now - (events[tail[t]] & ~1UL) >= delay[t + 1];
+  }
+
+  // Take the delayed impulse of the oldest event on tail t
+  int8_t pop(const uint8_t t) {
+    const bool rev = events[tail[t]] & 1;
+    tail[t] = (tail[t] + 1) & (SHAPING_BUFFER_SIZE - 1);
+    return impulse(rev, factor[t + 1]);
+  }
+
+  // Ticks until the next delayed impulse
+  uint32_t next_due(const uint32_t now) const {
+    uint32_t ticks = SHAPING_NEVER;
+    LOOP_L_N(t, 2) if (tail[t] != head) {
+      const uint32_t age = now - (events[tail[t]] & ~1UL);
+      NOMORE(ticks, age >= delay[t + 1] ? 0 : delay[t + 1] - age);
+    }
+    return ticks;
+  }
+};
@@ -1734,6 +1734,67 @@ void Temperature::manage_heater() {
   }                                                                       \
 }while(0)
 
+#if ENABLED(THERMISTOR_LUT)
+
+  /**
+   * Thermistor tables sampled at every 10-bit ADC count into RAM, in 1/16°C.
+   * A reading indexes the table by its top bits and interpolates with the rest.
+   */
+  constexpr uint8_t lut_shift(const uint32_t n, const uint8_t s=0) { return (2UL << s) <= n ? lut_shift(n, s + 1) : s; }
+  constexpr uint8_t LUT_SHIFT = lut_shift((OVERSAMPLENR) * (THERMISTOR_TABLE_SCALE));
+  constexpr uint16_t LUT_SIZE = ((MAX_RAW_THERMISTOR_VALUE) >> LUT_SHIFT) + 2;
+  #define LUT_FRAC_BITS 4
+
+  typedef int16_t thermistor_lut_t[LUT_SIZE];
+
+  #if HAS_HOTEND_THERMISTOR
+    static thermistor_lut_t hotend_lut[HOTENDS];
+  #endif
+  #if TEMP_SENSOR_BED_IS_THERMISTOR
+    static thermistor_lut_t bed_lut;
+  #endif
+
+  static celsius_float_t scan_thermistor_table(const temp_entry_t * const tbl, const uint8_t len, const int16_t raw) {
+    SCAN_THERMISTOR_TABLE(tbl, len);
+  }
+
+  static void build_thermistor_lut(thermistor_lut_t &lut, const temp_entry_t * const tbl, const uint8_t len) {
+    for (uint16_t i = 0; i < LUT_SIZE; i++) {
+      const int16_t raw = _MIN(uint32_t(i) << LUT_SHIFT, uint32_t(MAX_RAW_THERMISTOR_VALUE));
+      lut[i] = LROUND(scan_thermistor_table(tbl, len, raw) * _BV(LUT_FRAC_BITS));
+    }
+  }
+
+  static celsius_float_t lut_to_celsius(const thermistor_lut_t &lut, const int16_t raw) {
+    const uint16_t r = constrain(raw, 0, MAX_RAW_THERMISTOR_VALUE), i = r >> LUT_SHIFT;
+    const int32_t c = lut[i] + ((int32_t(lut[i + 1] - lut[i]) * (r & (_BV(LUT_SHIFT) - 1))) >> LUT_SHIFT);
+    return c * (1.0f / _BV(LUT_FRAC_BITS));
+  }
+
+  // Call when a thermistor type changes
+  void Temperature::refresh_thermistor_luts() {
+    #if HAS_HOTEND_THERMISTOR
+      HOTEND_LOOP() {
+        #if ENABLED(RS_ADDSETTINGS)
+          const thermistor_types_t &tt = thermistor_types[thermistors_data.heater_type[e]];
+          build_thermistor_lut(hotend_lut[e], tt.table, tt.table_size);
+        #else
+          if (heater_ttbllen_map[e]) build_thermistor_lut(hotend_lut[e], heater_ttbl_map[e], heater_ttbllen_map[e]);
+        #endif
+      }
+    #endif
+    #if TEMP_SENSOR_BED_IS_THERMISTOR
+      #if ENABLED(RS_ADDSETTINGS)
+        const thermistor_types_t &tt = thermistor_types[thermistors_data.bed_type];
+        build_thermistor_lut(bed_lut, tt.table, tt.table_size);
+      #else
+        build_thermistor_lut(bed_lut, TEMPTABLE_BED, TEMPTABLE_BED_LEN);
+      #endif
+    #endif
+  }
+
+#endif // THERMISTOR_LUT
+
 #if HAS_USER_THERMISTORS
 
   user_thermistor_t Temperature::user_thermistor[USER_THERMISTORS]; // Initialized by settings.load()
@@ -1966,7 +2027,9 @@ void Temperature::manage_heater() {
 
     #if HAS_HOTEND_THERMISTOR
       // Thermistor with conversion table?
-      #if ENABLED(RS_ADDSETTINGS)
+      #if ENABLED(THERMISTOR_LUT)
+        return lut_to_celsius(hotend_lut[e], raw);
+      #elif ENABLED(RS_ADDSETTINGS)
         SCAN_THERMISTOR_TABLE(thermistor_types[thermistors_data.heater_type[e]].table, thermistor_types[thermistors_data.heater_type[e]].table_size);
       #else
       const temp_entry_t(*tt)[] = (temp_entry_t(*)[])(heater_ttbl_map[e]);
@@ -1984,7 +2047,9 @@ void Temperature::manage_heater() {
     #if TEMP_SENSOR_BED_IS_CUSTOM
       return user_thermistor_to_deg_c(CTI_BED, raw);
     #elif TEMP_SENSOR_BED_IS_THERMISTOR
-      #if ENABLED(RS_ADDSETTINGS)
+      #if ENABLED(THERMISTOR_LUT)
+        return lut_to_celsius(bed_lut, raw);
+      #elif ENABLED(RS_ADDSETTINGS)
         SCAN_THERMISTOR_TABLE(thermistor_types[thermistors_data.bed_type].table, thermistor_types[thermistors_data.bed_type].table_size);
       #else
       SCAN_THERMISTOR_TABLE(TEMPTABLE_BED, TEMPTABLE_BED_LEN);
@@ -2222,6 +2287,8 @@ void Temperature::init() {
 
   TERN_(PROBING_HEATERS_OFF, paused_for_probing = false);
 
+  TERN_(THERMISTOR_LUT, refresh_thermistor_luts());
+
   #if BOTH(PIDTEMP, PID_EXTRUSION_SCALING)
     last_e_position = 0;
   #endif
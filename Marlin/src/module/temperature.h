@@ -625,6 +625,10 @@ class Temperature {
       }
     #endif
 
+    #if ENABLED(THERMISTOR_LUT)
+      static void refresh_thermistor_luts();
+    #endif
+
     #if HAS_HOTEND
       static celsius_float_t analog_to_celsius_hotend(const int16_t raw, const uint8_t e);
     #endif
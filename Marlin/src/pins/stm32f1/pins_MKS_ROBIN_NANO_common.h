@@ -45,6 +45,9 @@
   #define EEPROM_PAGE_SIZE     (0x800U) // 2KB
   #define EEPROM_START_ADDRESS (0x8000000UL + (STM32_FLASH_SIZE) * 1024UL - (EEPROM_PAGE_SIZE) * 2UL)
   #define MARLIN_EEPROM_SIZE    EEPROM_PAGE_SIZE  // 2KB
+  #ifdef ARDUINO_ARCH_STM32
+    #define FLASH_EEPROM_LOG                      // Append changes, erase only to compact
+  #endif
 #endif
 
 #define SPI_DEVICE                             2
@@ -29,6 +29,7 @@
 bool SDIO_Init();
 bool SDIO_ReadBlock(uint32_t block, uint8_t *dst);
 bool SDIO_WriteBlock(uint32_t block, const uint8_t *src);
+bool SDIO_ReadBlocks(uint32_t block, uint8_t *dst, uint16_t count);
 bool SDIO_IsReady();
 uint32_t SDIO_GetCardSize();
 
@@ -49,6 +50,8 @@ class DiskIODriver_SDIO : public DiskIODriver {
     bool readBlock(uint32_t block, uint8_t *dst)          override { return SDIO_ReadBlock(block, dst); }
     bool writeBlock(uint32_t block, const uint8_t *src)   override { return SDIO_WriteBlock(block, src); }
 
+    bool readBlocks(uint32_t block, uint8_t *dst, uint16_t count) override { return SDIO_ReadBlocks(block, dst, count); }
+
     uint32_t cardSize()                                   override { return SDIO_GetCardSize(); }
 
     bool isReady()                                        override { return SDIO_IsReady(); }
@@ -42,6 +42,13 @@
 #include "../MarlinCore.h"
 SdBaseFile *SdBaseFile::cwd_ = 0;   // Pointer to Current Working Directory
 
+#if HAS_SD_EXTENT_CACHE
+  SdBaseFile::extent_t SdBaseFile::extents_[SD_EXTENT_CACHE];
+  uint8_t SdBaseFile::extentCount_;
+  uint32_t SdBaseFile::extentEnd_;
+  const SdBaseFile *SdBaseFile::extentOwner_; // = nullptr
+#endif
+
 // callback function for date/time
 void (*SdBaseFile::dateTime_)(uint16_t *date, uint16_t *time) = 0;
 
@@ -92,6 +99,7 @@ bool SdBaseFile::addDirCluster() {
 // return pointer to cached entry or null for failure
 dir_t* SdBaseFile::cacheDirEntry(uint8_t action) {
   if (!vol_->cacheRawBlock(dirBlock_, action)) return nullptr;
+  if (action == SdVolume::CACHE_FOR_WRITE) vol_->writeStamp_++;
   return vol_->cache()->dir + dirIndex_;
 }
 
@@ -105,9 +113,55 @@ dir_t* SdBaseFile::cacheDirEntry(uint8_t action) {
 bool SdBaseFile::close() {
   bool rtn = sync();
   type_ = FAT_FILE_TYPE_CLOSED;
+  TERN_(HAS_SD_EXTENT_CACHE, if (hasExtents()) extentOwner_ = nullptr);
   return rtn;
 }
 
+#if HAS_SD_EXTENT_CACHE
+
+  /**
+   * Walk the cluster chain once and record where each run of contiguous
+   * clusters starts. A file with more runs than the map holds is mapped
+   * up to the last run that fits; the rest still goes through the FAT.
+   *
+   * \return true for success, false for failure.
+   */
+  bool SdBaseFile::mapExtents() {
+    extentOwner_ = nullptr;
+    if (!isFile() || !firstCluster_) return false;
+
+    const uint32_t clusters = fileSize_ ? ((fileSize_ - 1) >> (vol_->clusterSizeShift_ + 9)) + 1 : 1;
+    uint32_t cluster = firstCluster_, index = 0;
+    extents_[0] = { 0, cluster };
+    extentCount_ = 1;
+    while (++index < clusters) {
+      uint32_t next;
+      if (!vol_->fatGet(cluster, &next)) return false;
+      if (next != cluster + 1) {
+        if (extentCount_ == COUNT(extents_)) break;
+        extents_[extentCount_++] = { index, next };
+      }
+      cluster = next;
+    }
+    extentEnd_ = index;
+    extentOwner_ = this;
+    return true;
+  }
+
+  // Look up the cluster at 'index' in the file. False if it's past the map.
+  bool SdBaseFile::extentCluster(const uint32_t index, uint32_t *cluster) const {
+    if (index >= extentEnd_) return false;
+    uint8_t lo = 0, hi = extentCount_;
+    while (hi - lo > 1) {
+      const uint8_t mid = (lo + hi) >> 1;
+      if (extents_[mid].index <= index) lo = mid; else hi = mid;
+    }
+    *cluster = extents_[lo].cluster + (index - extents_[lo].index);
+    return true;
+  }
+
+#endif // HAS_SD_EXTENT_CACHE
+
 /**
  * Check for contiguous file and return its raw block range.
  *
@@ -1022,7 +1076,7 @@ int16_t SdBaseFile::read(void *buf, uint16_t nbyte) {
         // start of new cluster
         if (curPosition_ == 0)
           curCluster_ = firstCluster_;                      // use first cluster in file
-        else if (!vol_->fatGet(curCluster_, &curCluster_))  // get next cluster from FAT
+        else if (!nextCluster(curPosition_ >> (vol_->clusterSizeShift_ + 9), &curCluster_)) // get next cluster from map or FAT
           return -1;
       }
       block = vol_->clusterStartBlock(curCluster_) + blockOfCluster;
@@ -1034,7 +1088,26 @@ int16_t SdBaseFile::read(void *buf, uint16_t nbyte) {
 
     // no buffering needed if n == 512
     if (n == 512 && block != vol_->cacheBlockNumber()) {
-      if (!vol_->readBlock(block, dst)) return -1;
+      // Gather the following whole blocks that lie contiguous on the card,
+      // across cluster boundaries, and read them in one multi-block transfer.
+      // Stop short of the cached block, which may hold unwritten data.
+      uint16_t count = 1;
+      if (type_ != FAT_FILE_TYPE_ROOT_FIXED) {
+        const uint16_t want = toRead >> 9;
+        const uint32_t cached = vol_->cacheBlockNumber();
+        uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+        while (count < want && block + count != cached) {
+          if (++blockOfCluster == vol_->blocksPerCluster()) {
+            uint32_t next;
+            if (!nextCluster(((curPosition_ >> 9) + count) >> vol_->clusterSizeShift_, &next) || next != curCluster_ + 1) break;
+            curCluster_ = next;
+            blockOfCluster = 0;
+          }
+          count++;
+        }
+      }
+      if (!vol_->readBlocks(block, dst, count)) return -1;
+      n = count << 9;
     }
     else {
       // read block to cache and copy data to caller
@@ -1488,6 +1561,14 @@ bool SdBaseFile::seekSet(const uint32_t pos) {
   nCur = (curPosition_ - 1) >> (vol_->clusterSizeShift_ + 9);
   nNew = (pos - 1) >> (vol_->clusterSizeShift_ + 9);
 
+  #if HAS_SD_EXTENT_CACHE
+    // a mapped file finds the cluster directly
+    if (hasExtents() && extentCluster(nNew, &curCluster_)) {
+      curPosition_ = pos;
+      return true;
+    }
+  #endif
+
   if (nNew < nCur || curPosition_ == 0)
     curCluster_ = firstCluster_;      // must follow chain from first cluster
   else
@@ -324,6 +324,16 @@ class SdBaseFile {
    */
   bool seekEnd(const int32_t offset = 0) { return seekSet(fileSize_ + offset); }
   bool seekSet(const uint32_t pos);
+
+  #if HAS_SD_EXTENT_CACHE
+    /**
+     * Map the cluster chain of this file as runs of contiguous clusters,
+     * so reads and seeks find their cluster without walking the FAT.
+     * Only one file is mapped at a time.
+     */
+    bool mapExtents();
+    bool hasExtents() const { return extentOwner_ == this; }
+  #endif
   bool sync();
   bool timestamp(SdBaseFile *file);
   bool timestamp(uint8_t flag, uint16_t year, uint8_t month, uint8_t day,
@@ -366,6 +376,28 @@ class SdBaseFile {
   uint32_t  firstCluster_;  // first cluster of file
   SdVolume  *vol_;          // volume where file is located
 
+  #if HAS_SD_EXTENT_CACHE
+    typedef struct {
+      uint32_t index,         // index in the file of the first cluster of the run
+               cluster;       // cluster number on the volume
+    } extent_t;
+    static extent_t extents_[SD_EXTENT_CACHE];
+    static uint8_t extentCount_;              // runs in the map
+    static uint32_t extentEnd_;               // file clusters covered by the map
+    static const SdBaseFile *extentOwner_;    // the mapped file
+    bool extentCluster(const uint32_t index, uint32_t *cluster) const;
+  #endif
+
+  // Get the cluster at index 'index' of the file, following curCluster_
+  bool nextCluster(const uint32_t index, uint32_t *cluster) {
+    #if HAS_SD_EXTENT_CACHE
+      if (hasExtents() && extentCluster(index, cluster)) return true;
+    #else
+      UNUSED(index);
+    #endif
+    return vol_->fatGet(curCluster_, cluster);
+  }
+
   /**
    * EXPERIMENTAL - Don't use!
    */
@@ -44,6 +44,7 @@
   DiskIODriver *SdVolume::sdCard_;       // pointer to SD card object
   bool     SdVolume::cacheDirty_;        // cacheFlush() will write block if true
   uint32_t SdVolume::cacheMirrorBlock_;  // mirror  block for second FAT
+  uint32_t SdVolume::writeStamp_;        // bumped on directory/FAT writes
 #endif
 
 // find a contiguous group of clusters
@@ -198,6 +199,8 @@ bool SdVolume::fatGet(uint32_t cluster, uint32_t *value) {
 bool SdVolume::fatPut(uint32_t cluster, uint32_t value) {
   if (ENABLED(SDCARD_READONLY)) return false;
 
+  writeStamp_++;
+
   uint32_t lba;
   // error if reserved cluster
   if (cluster < 2) return false;
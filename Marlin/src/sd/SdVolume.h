@@ -83,6 +83,24 @@ class SdVolume {
     return &cacheBuffer_;
   }
 
+  /**
+   * Drop the cached block if another user of the media has rewritten it.
+   * A dirty cache is the one being written, so it's kept.
+   * Only FAT and FAT16 root directory blocks count as metadata writes here,
+   * since other directory blocks can't be told from file data.
+   */
+  void cacheInvalidate(const uint32_t block) {
+    if (block >= fatStartBlock_ && block < dataStartBlock_) writeStamp_++;
+    if (block == cacheBlockNumber_ && !cacheDirty_) cacheBlockNumber_ = 0xFFFFFFFF;
+  }
+
+  /**
+   * Count of metadata writes to the volume. Changes whenever a FAT entry or
+   * a directory entry is written, but not for file data, so cached listings
+   * can tell they are stale.
+   */
+  uint32_t writeStamp() const { return writeStamp_; }
+
   /**
    * Initialize a FAT volume.  Try partition one first then try super
    * floppy format.
@@ -144,12 +162,14 @@ class SdVolume {
     DiskIODriver *sdCard_;       // DiskIODriver object for cache
     bool cacheDirty_;            // cacheFlush() will write block if true
     uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    uint32_t writeStamp_;        // bumped on directory/FAT writes
   #else
     static cache_t cacheBuffer_;        // 512 byte cache for device blocks
     static uint32_t cacheBlockNumber_;  // Logical number of block in the cache
     static DiskIODriver *sdCard_;       // DiskIODriver object for cache
     static bool cacheDirty_;            // cacheFlush() will write block if true
     static uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    static uint32_t writeStamp_;        // bumped on directory/FAT writes
   #endif
 
   uint32_t allocSearchStart_;   // start cluster for alloc search
@@ -197,5 +217,6 @@ class SdVolume {
     return  cluster >= FAT32EOC_MIN;
   }
   bool readBlock(uint32_t block, uint8_t *dst) { return sdCard_->readBlock(block, dst); }
+  bool readBlocks(uint32_t block, uint8_t *dst, uint16_t count) { return sdCard_->readBlocks(block, dst, count); }
   bool writeBlock(uint32_t block, const uint8_t *dst) { return sdCard_->writeBlock(block, dst); }
 };
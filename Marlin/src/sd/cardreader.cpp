@@ -133,6 +133,14 @@ uint8_t CardReader::workDirDepth;
   CardReader::sdcard_driver_t CardReader::media_driver_sdcard;
 #endif
 
+#if HAS_SD_BLOCK_CACHE
+  DiskIOCache CardReader::media_cache;
+#endif
+
+#if HAS_SD_DIR_INDEX
+  CardReader::dir_index_t CardReader::dirIndex;
+#endif
+
 DiskIODriver* CardReader::driver = nullptr;
 SdVolume CardReader::volume;
 SdFile CardReader::file;
@@ -145,6 +153,11 @@ SdFile CardReader::file;
 
 uint32_t CardReader::filesize, CardReader::sdpos;
 
+#if HAS_SD_READ_AHEAD
+  uint8_t CardReader::readahead_buf[(SD_READ_AHEAD_BLOCKS) * 512] __attribute__((aligned(4)));
+  uint16_t CardReader::readahead_pos, CardReader::readahead_len;
+#endif
+
 CardReader::CardReader() {
   changeMedia(&
     #if HAS_USB_FLASH_DRIVE && !SHARED_VOLUME_IS(SD_ONBOARD)
@@ -237,9 +250,9 @@ int CardReader::countItems(SdFile dir) {
 //
 // Get file/folder info for an item by index
 //
-void CardReader::selectByIndex(SdFile dir, const uint8_t index) {
+void CardReader::selectByIndex(SdFile dir, const uint16_t index) {
   dir_t p;
-  for (uint8_t cnt = 0; dir.readDir(&p, longFilename) > 0;) {
+  for (uint16_t cnt = 0; dir.readDir(&p, longFilename) > 0;) {
     if (is_dir_or_gcode(p)) {
       if (cnt == index) {
         createFilename(filename, p);
@@ -745,8 +758,12 @@ void CardReader::printSelectedFilename() {
 
 void CardReader::mount(bool wifi) {
   flag.mounted = false;
+  TERN_(HAS_SD_DIR_INDEX, invalidateDirIndex());
   if (root.isOpen()) root.close();
 
+  // Writes by other users of the media (FatFs, USB MSC) drop the volume's stale block
+  TERN_(HAS_SD_BLOCK_CACHE, media_cache.addWriteHook([](const uint32_t block) { volume.cacheInvalidate(block); }));
+
   if (!driver->init(SD_SPI_SPEED, SDSS)
     #if defined(LCD_SDSS) && (LCD_SDSS != SDSS)
       && !driver->init(SD_SPI_SPEED, LCD_SDSS)
@@ -849,6 +866,7 @@ void CardReader::release() {
 
   flag.mounted = false;
   flag.workDirIsRoot = true;
+  TERN_(HAS_SD_DIR_INDEX, invalidateDirIndex());
   #if ALL(SDCARD_SORT_ALPHA, SDSORT_USES_RAM, SDSORT_CACHE_NAMES)
     nrFiles = 0;
   #endif
@@ -874,6 +892,8 @@ void CardReader::openAndPrintFile(const char *name) {
  */
 void CardReader::startOrResumeFilePrinting() {
   if (isMounted()) {
+    // Map the file clusters once, before the reads and seeks of the print
+    TERN_(HAS_SD_EXTENT_CACHE, if (isFileOpen() && !file.hasExtents()) file.mapExtents());
     flag.sdprinting = true;
     flag.sdprintdone = false;
     TERN_(SD_RESORT, flush_presort());
@@ -888,6 +908,7 @@ void CardReader::endFilePrintNow(TERN_(SD_RESORT, const bool re_sort/*=false*/))
   TERN_(HAS_DWIN_E3V2_BASIC, HMI_flag.print_finish = flag.sdprinting);
   flag.abort_sd_printing = false;
   if (isFileOpen()) file.close();
+  TERN_(HAS_SD_READ_AHEAD, readahead_pos = readahead_len = 0);
   TERN_(SD_RESORT, if (re_sort) presort());
 }
 
@@ -995,6 +1016,7 @@ void CardReader::openFileRead(const char * const path, const uint8_t subcall_typ
   if (file.open(diveDir, fname, O_READ)) {
     filesize = file.fileSize();
     sdpos = 0;
+    TERN_(HAS_SD_READ_AHEAD, readahead_pos = readahead_len = 0);
 
     { // Don't remove this block, as the PORT_REDIRECT is a RAII
       PORT_REDIRECT(SerialMask::All);
@@ -1021,6 +1043,7 @@ inline void echo_write_to_file(const char * const fname) {
 //
 void CardReader::openFileWrite(const char * const path) {
   if (!isMounted()) return;
+  if (isWriteLocked()) { openFailed(path); return; }
 
   announceOpen(2, path);
   TERN_(HAS_MEDIA_SUBCALLS, file_subcall_ctr = 0);
@@ -1036,6 +1059,7 @@ void CardReader::openFileWrite(const char * const path) {
   #else
     if (file.open(diveDir, fname, O_CREAT | O_APPEND | O_WRITE | O_TRUNC)) {
       flag.saving = true;
+      TERN_(HAS_SD_READ_AHEAD, readahead_pos = readahead_len = 0);
       selectFileByName(fname);
       TERN_(EMERGENCY_PARSER, emergency_parser.disable());
       echo_write_to_file(fname);
@@ -1077,6 +1101,7 @@ bool CardReader::fileExists(const char * const path) {
 //
 void CardReader::removeFile(const char * const name) {
   if (!isMounted()) return;
+  if (isWriteLocked()) { SERIAL_ECHOLNPGM("Deletion failed (card busy), File: ", name, "."); return; }
 
   //abortFilePrintNow();
 
@@ -1173,6 +1198,7 @@ void CardReader::closefile(const bool store_location/*=false*/) {
   file.close();
   flag.saving = flag.logging = false;
   sdpos = 0;
+  TERN_(HAS_SD_READ_AHEAD, readahead_pos = readahead_len = 0);
   TERN_(EMERGENCY_PARSER, emergency_parser.enable());
 
   if (store_location) {
@@ -1193,6 +1219,17 @@ void CardReader::selectFileByIndex(const uint16_t nr) {
       return;
     }
   #endif
+  #if HAS_SD_DIR_INDEX
+    // Seek straight to the item. readDir also collects its long name entries.
+    if (indexWorkDir() && nr < _MIN(dirIndex.count, SD_DIR_INDEX)) {
+      dir_t p;
+      if (workDir.seekSet(uint32_t(dirIndex.entry[nr]) << 5) && workDir.readDir(&p, longFilename) > 0 && is_dir_or_gcode(p)) {
+        createFilename(filename, p);
+        return;
+      }
+      invalidateDirIndex();
+    }
+  #endif
   workDir.rewind();
   selectByIndex(workDir, nr);
 }
@@ -1215,10 +1252,55 @@ void CardReader::selectFileByName(const char * const match) {
 }
 
 uint16_t CardReader::countFilesInWorkDir() {
+  #if HAS_SD_DIR_INDEX
+    if (indexWorkDir()) {
+      #if ALL(SDCARD_SORT_ALPHA, SDSORT_USES_RAM, SDSORT_CACHE_NAMES)
+        nrFiles = dirIndex.count;
+      #endif
+      return dirIndex.count;
+    }
+  #endif
   workDir.rewind();
   return countItems(workDir);
 }
 
+#if HAS_SD_DIR_INDEX
+
+  /**
+   * Index the compliant items of the working directory by the directory
+   * entry where each one starts (its first long name entry). The file
+   * browser then counts and pages without rescanning the directory.
+   *
+   * The index is kept until the working directory changes, the media is
+   * remounted, or a directory or FAT block is written (volume write stamp).
+   * Items past SD_DIR_INDEX are counted but located by a scan, as before.
+   */
+  bool CardReader::indexWorkDir() {
+    if (!isMounted() || !workDir.isOpen()) return false;
+
+    const uint32_t cluster = workDir.firstCluster(), stamp = volume.writeStamp();
+    if (dirIndex.valid && dirIndex.cluster == cluster && dirIndex.stamp == stamp) return true;
+
+    dir_t p;
+    uint16_t c = 0;
+    workDir.rewind();
+    for (;;) {
+      const uint32_t pos = workDir.curPosition();
+      if (workDir.readDir(&p, longFilename) <= 0) break;
+      if (!is_dir_or_gcode(p)) continue;
+      if (c < SD_DIR_INDEX) dirIndex.entry[c] = pos >> 5;
+      c++;
+    }
+
+    dirIndex.valid = true;
+    dirIndex.cluster = cluster;
+    dirIndex.stamp = stamp;
+    dirIndex.count = c;
+    return true;
+  }
+
+#endif // HAS_SD_DIR_INDEX
+
 /**
  * Dive to the given DOS 8.3 file path, with optional echo of the dive paths.
  *
@@ -1597,11 +1679,44 @@ uint16_t CardReader::get_num_Files() {
   );
 }
 
+#if HAS_SD_READ_AHEAD
+
+  /**
+   * Refill the read-ahead buffer from the file position. Reads start on a
+   * sector boundary so whole sectors go out as one multi-block transfer,
+   * and the buffer stays word-aligned for the SDIO DMA.
+   */
+  bool CardReader::fillReadAhead() {
+    readahead_pos = readahead_len = 0;
+    if (!file.isOpen()) return false;
+
+    sdpos = file.curPosition();
+    const uint16_t lead = sdpos & 0x1FF;
+    if (lead && !file.seekSet(sdpos - lead)) return false;
+
+    const int16_t n = file.read(readahead_buf, sizeof(readahead_buf));
+    if (n <= lead) { file.seekSet(sdpos); return false; }
+
+    readahead_pos = lead;
+    readahead_len = n;
+    return true;
+  }
+
+  // Put the file position back where get() left off, for direct reads and writes
+  void CardReader::dropReadAhead() {
+    if (readahead_pos < readahead_len)
+      file.seekSet(file.curPosition() - (readahead_len - readahead_pos));
+    readahead_pos = readahead_len = 0;
+  }
+
+#endif // HAS_SD_READ_AHEAD
+
 //
 // Return from procedure or close out the Print Job
 //
 void CardReader::fileHasFinished() {
   file.close();
+  TERN_(HAS_SD_READ_AHEAD, readahead_pos = readahead_len = 0);
   #if HAS_MEDIA_SUBCALLS
     if (file_subcall_ctr > 0) { // Resume calling file after closing procedure
       file_subcall_ctr--;
@@ -1633,6 +1748,7 @@ void CardReader::fileHasFinished() {
   void CardReader::openJobRecoveryFile(const bool read) {
     if (!isMounted()) return;
     if (recovery.file.isOpen()) return;
+    if (!read && isWriteLocked()) return; // Skip the save, the card is being written by an upload
     if (!recovery.file.open(&root, recovery.filename, read ? O_READ : O_CREAT | O_WRITE | O_TRUNC | O_SYNC))
       openFailed(recovery.filename);
     else if (!read)
@@ -27,6 +27,10 @@
 
 extern const char M23_STR[], M24_STR[];
 
+#if ENABLED(MKS_WIFI_BACKGROUND_UPLOAD)
+  bool mks_wifi_upload_active();
+#endif
+
 #if ENABLED(SDCARD_SORT_ALPHA)
   #if ENABLED(SDSORT_DYNAMIC_RAM)
     #define SD_RESORT 1
@@ -49,6 +53,10 @@ extern const char M23_STR[], M24_STR[];
 #include "SdFile.h"
 #include "disk_io_driver.h"
 
+#if HAS_SD_BLOCK_CACHE
+  #include "disk_io_cache.h"
+#endif
+
 #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
   #include "usb_flashdrive/Sd2Card_FlashDrive.h"
 #endif
@@ -109,7 +117,14 @@ public:
 
   CardReader();
 
-  static void changeMedia(DiskIODriver *_driver) { driver = _driver; }
+  static void changeMedia(DiskIODriver *_driver) {
+    #if HAS_SD_BLOCK_CACHE
+      media_cache.attach(_driver);
+      driver = &media_cache;
+    #else
+      driver = _driver;
+    #endif
+  }
 
   static SdFile getroot() { return root; }
 
@@ -148,6 +163,10 @@ public:
   static void cd(const char *relpath);
   static int8_t cdup();
   static uint16_t countFilesInWorkDir();
+
+  #if HAS_SD_DIR_INDEX
+    static void invalidateDirIndex() { dirIndex.valid = false; }
+  #endif
   static uint16_t get_num_Files();
 
   // Select a file
@@ -220,13 +239,26 @@ public:
   static uint32_t getFileSize()  { return filesize; }
   static uint32_t getIndex()     { return sdpos; }
   static bool isFileOpen()       { return isMounted() && file.isOpen(); }
+  static bool isFileWrite()      { return isFileOpen() && flag.saving; }
+
+  // Only one writer may own the FAT. A background WiFi upload writes with FatFs.
+  static bool isWriteLocked()    { return TERN0(MKS_WIFI_BACKGROUND_UPLOAD, mks_wifi_upload_active()); }
   static bool eof()              { return getIndex() >= getFileSize(); }
+  static bool getFileDirEntry(dir_t * const dir) { return file.isOpen() && file.dirEntry(dir); }
 
   // File data operations
-  static int16_t get()                            { int16_t out = (int16_t)file.read(); sdpos = file.curPosition(); return out; }
-  static int16_t read(void *buf, uint16_t nbyte)  { return file.isOpen() ? file.read(buf, nbyte) : -1; }
-  static int16_t write(void *buf, uint16_t nbyte) { return file.isOpen() ? file.write(buf, nbyte) : -1; }
-  static void setIndex(const uint32_t index)      { file.seekSet((sdpos = index)); }
+  #if HAS_SD_READ_AHEAD
+    static int16_t get() {
+      if (readahead_pos >= readahead_len && !fillReadAhead()) return -1;
+      sdpos++;
+      return readahead_buf[readahead_pos++];
+    }
+  #else
+    static int16_t get()                          { int16_t out = (int16_t)file.read(); sdpos = file.curPosition(); return out; }
+  #endif
+  static int16_t read(void *buf, uint16_t nbyte)  { TERN_(HAS_SD_READ_AHEAD, dropReadAhead()); return file.isOpen() ? file.read(buf, nbyte) : -1; }
+  static int16_t write(void *buf, uint16_t nbyte) { TERN_(HAS_SD_READ_AHEAD, dropReadAhead()); return file.isOpen() ? file.write(buf, nbyte) : -1; }
+  static void setIndex(const uint32_t index)      { TERN_(HAS_SD_READ_AHEAD, readahead_pos = readahead_len = 0); file.seekSet((sdpos = index)); }
 
   // TODO: rename to diskIODriver()
   static DiskIODriver* diskIODriver() { return driver; }
@@ -249,6 +281,10 @@ public:
     static sdcard_driver_t media_driver_sdcard;
   #endif
 
+  #if HAS_SD_BLOCK_CACHE
+    static DiskIOCache media_cache;   // Shared sector cache in front of the media driver
+  #endif
+
 private:
   //
   // Working directory and parents
@@ -319,6 +355,16 @@ private:
   static uint32_t filesize, // Total size of the current file, in bytes
                   sdpos;    // Index most recently read (one behind file.getPos)
 
+  //
+  // Sectors of the current file read ahead of get()
+  //
+  #if HAS_SD_READ_AHEAD
+    static uint8_t readahead_buf[(SD_READ_AHEAD_BLOCKS) * 512];
+    static uint16_t readahead_pos, readahead_len;
+    static bool fillReadAhead();
+    static void dropReadAhead();
+  #endif
+
   //
   // Procedure calls to other files
   //
@@ -333,7 +379,7 @@ private:
   //
   static bool is_dir_or_gcode(const dir_t &p);
   static int countItems(SdFile dir);
-  static void selectByIndex(SdFile dir, const uint8_t index);
+  static void selectByIndex(SdFile dir, const uint16_t index);
   static void selectByName(SdFile dir, const char * const match);
   static void printListing(
     SdFile parent
@@ -345,6 +391,21 @@ private:
   #if ENABLED(SDCARD_SORT_ALPHA)
     static void flush_presort();
   #endif
+
+  //
+  // Directory index
+  //
+  #if HAS_SD_DIR_INDEX
+    typedef struct {
+      bool valid;
+      uint32_t cluster,             // First cluster of the indexed directory
+               stamp;               // Volume write stamp when it was indexed
+      uint16_t count,               // Compliant items in the directory
+               entry[SD_DIR_INDEX]; // Directory entry where each item starts
+    } dir_index_t;
+    static dir_index_t dirIndex;
+    static bool indexWorkDir();
+  #endif
 };
 
 #if ENABLED(USB_FLASH_DRIVE_SUPPORT)
@@ -0,0 +1,94 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "../inc/MarlinConfig.h"
+
+#if HAS_SD_BLOCK_CACHE
+
+#include "disk_io_cache.h"
+
+void DiskIOCache::invalidate() {
+  LOOP_L_N(i, SD_BLOCK_CACHE) { block[i] = 0xFFFFFFFF; used[i] = 0; }
+  stamp = 0;
+}
+
+bool DiskIOCache::addWriteHook(const writeHook_t hook) {
+  LOOP_L_N(i, DISK_IO_CACHE_HOOKS) if (hooks[i] == hook) return true;
+  LOOP_L_N(i, DISK_IO_CACHE_HOOKS) if (!hooks[i]) { hooks[i] = hook; return true; }
+  return false;
+}
+
+void DiskIOCache::removeWriteHook(const writeHook_t hook) {
+  LOOP_L_N(i, DISK_IO_CACHE_HOOKS) if (hooks[i] == hook) hooks[i] = nullptr;
+}
+
+int8_t DiskIOCache::find(const uint32_t b) const {
+  LOOP_L_N(i, SD_BLOCK_CACHE) if (block[i] == b) return i;
+  return -1;
+}
+
+bool DiskIOCache::readBlock(uint32_t b, uint8_t *dst) {
+  int8_t i = find(b);
+  if (i < 0) {
+    // Replace the least recently used block. The slots are word-aligned
+    // for the DMA, so callers may pass any buffer.
+    i = 0;
+    LOOP_S_L_N(j, 1, SD_BLOCK_CACHE) if (used[j] < used[i]) i = j;
+    block[i] = 0xFFFFFFFF;
+    if (!media->readBlock(b, data[i])) return false;
+    block[i] = b;
+  }
+  used[i] = ++stamp;
+  memcpy(dst, data[i], 512);
+  return true;
+}
+
+// Keep a cached copy current and tell the other users about the write
+void DiskIOCache::written(const uint32_t b, const uint8_t *src) {
+  const int8_t i = find(b);
+  if (i >= 0) memcpy(data[i], src, 512);
+  LOOP_L_N(h, DISK_IO_CACHE_HOOKS) if (hooks[h]) hooks[h](b);
+}
+
+bool DiskIOCache::writeBlock(uint32_t b, const uint8_t *src) {
+  const bool ok = media->writeBlock(b, src);
+  if (ok) written(b, src);
+  else {
+    // The card content is unknown now
+    const int8_t i = find(b);
+    if (i >= 0) block[i] = 0xFFFFFFFF;
+  }
+  return ok;
+}
+
+bool DiskIOCache::writeData(const uint8_t *src) {
+  const bool ok = media->writeData(src);
+  if (ok) written(writeNext, src);
+  else {
+    const int8_t i = find(writeNext);
+    if (i >= 0) block[i] = 0xFFFFFFFF;
+  }
+  writeNext++;
+  return ok;
+}
+
+#endif // HAS_SD_BLOCK_CACHE
@@ -0,0 +1,87 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (c) 2021 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (c) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#pragma once
+
+/**
+ * disk_io_cache.h - Sector cache shared by every filesystem on the media
+ *
+ * Sits between the media driver and its users (SdVolume, the FatFs glue
+ * of MKS WiFi, USB MSC) so they share warm FAT and directory sectors.
+ * Writes go straight through to the media, so the card is always current.
+ * Single-block reads are cached; multi-block reads of file data bypass it.
+ *
+ * Users with their own sector buffer register a write hook to drop a
+ * buffered copy of a block that another user has rewritten.
+ */
+
+#include "../inc/MarlinConfig.h"
+#include "SdInfo.h"
+#include "disk_io_driver.h"
+
+#define DISK_IO_CACHE_HOOKS 2
+
+class DiskIOCache : public DiskIODriver {
+  public:
+    typedef void (*writeHook_t)(const uint32_t block);
+
+    void attach(DiskIODriver * const driver) { media = driver; invalidate(); }
+    DiskIODriver* attached() const { return media; }
+
+    void invalidate();
+
+    bool addWriteHook(const writeHook_t hook);
+    void removeWriteHook(const writeHook_t hook);
+
+    bool init(const uint8_t sckRateID, const pin_t chipSelectPin) override { invalidate(); return media->init(sckRateID, chipSelectPin); }
+
+    bool readCSD(csd_t *csd)                                  override { return media->readCSD(csd); }
+
+    bool readStart(const uint32_t block)                      override { return media->readStart(block); }
+    bool readData(uint8_t *dst)                               override { return media->readData(dst); }
+    bool readStop()                                           override { return media->readStop(); }
+
+    bool writeStart(const uint32_t block, const uint32_t n)   override { writeNext = block; return media->writeStart(block, n); }
+    bool writeData(const uint8_t *src)                        override;
+    bool writeStop()                                          override { return media->writeStop(); }
+
+    bool readBlock(uint32_t block, uint8_t *dst)              override;
+    bool writeBlock(uint32_t block, const uint8_t *src)       override;
+    bool readBlocks(uint32_t block, uint8_t *dst, uint16_t count) override { return media->readBlocks(block, dst, count); }
+
+    uint32_t cardSize()                                       override { return media->cardSize(); }
+    bool isReady()                                            override { return media->isReady(); }
+    void idle()                                               override { media->idle(); }
+
+  private:
+    DiskIODriver *media;
+    uint32_t writeNext;                       // Next block of a multi-block write
+
+    uint32_t block[SD_BLOCK_CACHE],           // Cached block numbers, 0xFFFFFFFF when free
+             used[SD_BLOCK_CACHE],            // Access stamps for LRU replacement
+             stamp;
+    uint8_t data[SD_BLOCK_CACHE][512] __attribute__((aligned(4)));
+
+    writeHook_t hooks[DISK_IO_CACHE_HOOKS];
+
+    int8_t find(const uint32_t b) const;
+    void written(const uint32_t b, const uint8_t *src);
+};
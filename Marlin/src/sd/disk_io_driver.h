@@ -22,6 +22,7 @@
 #pragma once
 
 #include <stdint.h>
+#include "SdInfo.h"
 
 /**
  * DiskIO Interface
@@ -59,6 +60,19 @@ public:
   virtual bool readBlock(uint32_t block, uint8_t* dst) = 0;
   virtual bool writeBlock(uint32_t blockNumber, const uint8_t* src) = 0;
 
+  /**
+   * Read consecutive blocks into dst. Drivers that can move several blocks
+   * with one command override this. The default streams them one by one.
+   *
+   * \return true for success or false for failure.
+   */
+  virtual bool readBlocks(uint32_t block, uint8_t* dst, uint16_t count) {
+    if (!readStart(block)) return false;
+    for (; count; count--, dst += 512)
+      if (!readData(dst)) { readStop(); return false; }
+    return readStop();
+  }
+
   virtual uint32_t cardSize() = 0;
 
   virtual bool isReady() = 0;
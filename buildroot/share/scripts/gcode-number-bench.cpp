@@ -0,0 +1,110 @@
+/**
+ * gcode-number-bench.cpp - Host benchmark for the G-code number parser
+ *
+ * Times GCodeParser::value_float() as it was (libc strtof, with 'E' cut off)
+ * against gcode_strtof() from Marlin/src/libs/strtonum.h over the parameter
+ * values of real G-code files, and checks that both agree.
+ *
+ * Usage, from the repository root:
+ *
+ *   g++ -O2 -o /tmp/gcode-number-bench buildroot/share/scripts/gcode-number-bench.cpp
+ *   /tmp/gcode-number-bench buildroot/test-gcode/M808-loops.gcode my-sliced-part.gcode
+ *
+ * Host timings show the relative gain only. On an MCU without an FPU the
+ * libc path is soft-float and the difference is much larger.
+ */
+
+#include "../../../Marlin/src/libs/strtonum.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// value_float() before strtonum.h
+static float libc_value_float(char * const value_ptr) {
+  char *e = value_ptr;
+  for (;;) {
+    const char c = *e;
+    if (c == '\0' || c == ' ') break;
+    if (c == 'E' || c == 'e') {
+      *e = '\0';
+      const float ret = strtof(value_ptr, nullptr);
+      *e = c;
+      return ret;
+    }
+    ++e;
+  }
+  return strtof(value_ptr, nullptr);
+}
+
+static bool is_value_start(const char c) { return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.'; }
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    fprintf(stderr, "Usage: %s file.gcode [...]\n", argv[0]);
+    return 1;
+  }
+
+  // Keep each line's code, without comments, and point at every parameter value
+  std::vector<std::string> lines;
+  for (int i = 1; i < argc; i++) {
+    std::ifstream in(argv[i]);
+    if (!in) { fprintf(stderr, "Can't open %s\n", argv[i]); return 1; }
+    for (std::string line; std::getline(in, line);) {
+      const size_t semi = line.find(';');
+      if (semi != std::string::npos) line.erase(semi);
+      if (line.find_first_not_of(" \t\r") != std::string::npos) lines.push_back(line);
+    }
+  }
+
+  std::vector<char*> values;
+  for (std::string &line : lines)
+    for (size_t i = 1; i < line.size(); i++)
+      if (isalpha(line[i - 1]) && is_value_start(line[i])) values.push_back(&line[i]);
+
+  if (values.empty()) { fprintf(stderr, "No parameter values found\n"); return 1; }
+
+  // Agreement with libc
+  size_t differ = 0;
+  double max_rel = 0;
+  for (char * const v : values) {
+    const float a = libc_value_float(v), b = gcode_strtof(v);
+    if (a != b) {
+      differ++;
+      const double rel = fabs((double)a - b) / (a ? fabs(a) : 1.0);
+      if (rel > max_rel) max_rel = rel;
+    }
+    if (strtol(v, nullptr, 10) != gcode_strtol(v)) {
+      fprintf(stderr, "strtol mismatch: %s\n", v);
+      return 1;
+    }
+  }
+
+  // Repeat the whole set for at least ~20M conversions
+  const size_t reps = values.size() >= 20000000 ? 1 : 20000000 / values.size() + 1;
+  volatile float sink;
+
+  auto bench = [&](const char * const name, float (*conv)(char*)) {
+    const auto t0 = std::chrono::steady_clock::now();
+    float sum = 0;
+    for (size_t r = 0; r < reps; r++)
+      for (char * const v : values) sum += conv(v);
+    sink = sum;
+    const double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    printf("%-10s %8.1f ns/value %12.0f lines/s\n", name, s * 1e9 / (reps * values.size()), reps * lines.size() / s);
+    return s;
+  };
+
+  printf("%zu lines, %zu values, %zu passes\n", lines.size(), values.size(), reps);
+  const double t_libc = bench("strtof", libc_value_float),
+               t_fast = bench("strtonum", [](char *v) { return gcode_strtof(v); });
+  printf("speedup    %8.2fx\n", t_libc / t_fast);
+  printf("differ     %zu of %zu values (max relative error %g)\n", differ, values.size(), max_rel);
+  (void)sink;
+  return 0;
+}